@@ -135,8 +135,8 @@ void DSMEAdaptionLayer::setConfirmCallback(confirmCallback_t callback_confirm) {
     return;
 }
 
-void DSMEAdaptionLayer::sendMessage(IDSMEMessage* msg) {
-    this->messageHelper.sendMessage(msg);
+void DSMEAdaptionLayer::sendMessage(IDSMEMessage* msg, uint8_t priority) {
+    this->messageHelper.sendMessage(msg, priority);
 }
 
 void DSMEAdaptionLayer::startAssociation() {
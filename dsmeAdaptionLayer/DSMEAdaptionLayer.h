@@ -97,7 +97,10 @@ public:
     void setIndicationCallback(indicationCallback_t);
     void setConfirmCallback(confirmCallback_t);
 
-    void sendMessage(IDSMEMessage* msg);
+    /*
+     * @param priority priority class in the GTS queue, 0 is the least urgent, see DSME_GTS_QUEUE_PRIORITY_CLASSES
+     */
+    void sendMessage(IDSMEMessage* msg, uint8_t priority = 0);
     void startAssociation();
 
     uint16_t getRandom();
@@ -59,7 +59,7 @@
 
 namespace dsme {
 
-GTSHelper::GTSHelper(DSMEAdaptionLayer& dsmeAdaptionLayer) : dsmeAdaptionLayer(dsmeAdaptionLayer), gtsConfirmPending(false) {
+GTSHelper::GTSHelper(DSMEAdaptionLayer& dsmeAdaptionLayer) : dsmeAdaptionLayer(dsmeAdaptionLayer), numPendingAllocations(0), lastAllocationFailed(false) {
 }
 
 void GTSHelper::initialize(GTSScheduling* scheduling) {
@@ -74,7 +74,8 @@ void GTSHelper::initialize(GTSScheduling* scheduling) {
 }
 
 void GTSHelper::reset() {
-    this->gtsConfirmPending = false;
+    this->numPendingAllocations = 0;
+    this->lastAllocationFailed = false;
     this->gtsScheduling->reset();
 }
 
@@ -98,8 +99,10 @@ void GTSHelper::handleStartOfCFP() {
     /* Check allocation at random superframe in multi-superframe */
     uint8_t num_superframes = this->dsmeAdaptionLayer.getMAC_PIB().helper.getNumberSuperframesPerMultiSuperframe();
     uint8_t random_frame = this->dsmeAdaptionLayer.getDSME().getPlatform().getRandom() % num_superframes;
+    expirePendingAllocations();
+
     //if(this->dsmeAdaptionLayer.getDSME().getCurrentSuperframe() == random_frame) {
-    performSchedulingAction(this->gtsScheduling->getNextSchedulingAction());
+    performSchedulingActions();
     //}
     return;
 }
@@ -109,32 +112,50 @@ void GTSHelper::checkAllocationForPacket(uint16_t address) {
     return;
 }
 
-void GTSHelper::performSchedulingAction(GTSSchedulingDecision decision) {
+/* returns true if another allocation request was issued */
+bool GTSHelper::performSchedulingAction(GTSSchedulingDecision decision) {
     if(decision.numSlot == 0) {
         LOG_DEBUG("NO SCHEDULING ACTION");
         DSME_ASSERT(decision.deviceAddress == IEEE802154MacAddress::NO_SHORT_ADDRESS);
-        return;
+        return false;
     }
     LOG_DEBUG("GTSHelper: performSchedulingAction");
 
     if(decision.managementType == ManagementType::ALLOCATION) {
-        checkAndAllocateGTS(decision);
+        return checkAndAllocateGTS(decision);
     } else if(decision.managementType == ManagementType::DEALLOCATION) {
         checkAndDeallocateSingeleGTS(decision.deviceAddress);
     } else {
         DSME_ASSERT(false);
     }
-    return;
+    return false;
 }
 
-void GTSHelper::checkAndAllocateGTS(GTSSchedulingDecision decision) {
-    DSME_ATOMIC_BLOCK {
-        if(gtsConfirmPending) {
-            LOG_INFO("GTS allocation still active (trying with 0x" << HEXOUT << decision.deviceAddress << DECOUT << ")");
-            return;
+void GTSHelper::performSchedulingActions() {
+    /* The scheduler accounts for pending allocations, so every round either serves the next link or stops.
+     * This must not be called while the GTSManager dispatches an event, see handleDSME_GTS_confirm. */
+    for(uint8_t i = 0; i < DSME_MAX_PENDING_GTS_ALLOCATIONS; i++) {
+        if(!performSchedulingAction(this->gtsScheduling->getNextSchedulingAction())) {
+            break;
         }
+    }
+}
 
-        gtsConfirmPending = true;
+bool GTSHelper::checkAndAllocateGTS(GTSSchedulingDecision decision) {
+    bool full;
+    bool pending;
+    DSME_ATOMIC_BLOCK {
+        full = (this->numPendingAllocations == DSME_MAX_PENDING_GTS_ALLOCATIONS);
+        pending = (this->numPendingAllocations > 0);
+    }
+    if(full) {
+        LOG_INFO("GTS allocations still active (trying with 0x" << HEXOUT << decision.deviceAddress << DECOUT << ")");
+        return false;
+    }
+    if(pending && (this->lastAllocationFailed || this->dsmeAdaptionLayer.getDSME().getCapLayer().hasQueuedMessages())) {
+        /* '-> a further request only adds to the contention while the CAP is backed up or the last request failed */
+        LOG_INFO("GTS allocation deferred (trying with 0x" << HEXOUT << decision.deviceAddress << DECOUT << ")");
+        return false;
     }
 
     DSMEAllocationCounterTable& macDSMEACT = this->dsmeAdaptionLayer.getMAC_PIB().macDSMEACT;
@@ -146,8 +167,7 @@ void GTSHelper::checkAndAllocateGTS(GTSSchedulingDecision decision) {
 
     if(preferredGTS == GTS::UNDEFINED) {
         LOG_ERROR("No free GTS found! (trying with 0x" << HEXOUT << decision.deviceAddress << DECOUT << ")");
-        gtsConfirmPending = false;
-        return;
+        return false;
     }
 
     mlme_sap::DSME_GTS::request_parameters params;
@@ -167,28 +187,143 @@ void GTSHelper::checkAndAllocateGTS(GTSSchedulingDecision decision) {
                                 << params.deviceAddress << DECOUT << ".");
 
     /* mark all impossible slots that are in use in other channels, too */
-    for(DSMEAllocationCounterTable::iterator it = macDSMEACT.begin(); it != macDSMEACT.end(); ++it) {
-        if(it->getSuperframeID() == preferredGTS.superframeID) {
+    DSMEAllocationCounterTable::iterator last = macDSMEACT.endSuperframe(preferredGTS.superframeID);
+    for(DSMEAllocationCounterTable::iterator it = macDSMEACT.beginSuperframe(preferredGTS.superframeID); it != last; ++it) {
+        for(uint8_t channel = 0; channel < numChannels; channel++) {
+            params.dsmeSabSpecification.getSubBlock().set(it->getGTSlotID() * numChannels + channel, true);
+        }
+    }
+
+    /* the responder shall not pick the slots other pending requests might be granted */
+    uint8_t numGTSlots = this->dsmeAdaptionLayer.getMAC_PIB().helper.getNumGTSlots(preferredGTS.superframeID);
+    for(uint8_t i = 0; i < this->numPendingAllocations; i++) {
+        if(this->pendingAllocations[i].superframeID == preferredGTS.superframeID) {
+            for(uint8_t slotID = 0; slotID < numGTSlots; slotID++) {
+                if(this->pendingAllocations[i].proposedSlots.get(slotID)) {
+                    for(uint8_t channel = 0; channel < numChannels; channel++) {
+                        params.dsmeSabSpecification.getSubBlock().set(slotID * numChannels + channel, true);
+                    }
+                }
+            }
+        }
+    }
+
+    /* register before the request, its confirm might be delivered right away */
+    DSME_ATOMIC_BLOCK {
+        PendingAllocation& pending = this->pendingAllocations[this->numPendingAllocations++];
+        pending.address = params.deviceAddress;
+        pending.direction = params.direction;
+        pending.superframeID = preferredGTS.superframeID;
+        pending.superframesPending = 0;
+
+        /* '-> every slot with a free channel left in the SAB specification might be granted */
+        pending.proposedSlots.setLength(numGTSlots);
+        for(uint8_t slotID = 0; slotID < numGTSlots; slotID++) {
+            bool proposed = false;
             for(uint8_t channel = 0; channel < numChannels; channel++) {
-                params.dsmeSabSpecification.getSubBlock().set(it->getGTSlotID() * numChannels + channel, true);
+                if(!params.dsmeSabSpecification.getSubBlock().get(slotID * numChannels + channel)) {
+                    proposed = true;
+                    break;
+                }
             }
+            pending.proposedSlots.set(slotID, proposed);
         }
     }
 
     this->dsmeAdaptionLayer.getMLME_SAP().getDSME_GTS().request(params);
-    return;
+    return true;
+}
+
+uint8_t GTSHelper::getNumPendingAllocations(uint16_t address, Direction direction) const {
+    uint8_t count = 0;
+    for(uint8_t i = 0; i < this->numPendingAllocations; i++) {
+        if(this->pendingAllocations[i].address == address && this->pendingAllocations[i].direction == direction) {
+            count++;
+        }
+    }
+    return count;
+}
+
+bool GTSHelper::isTentativelyReserved(uint16_t superframeID, uint16_t slotID) const {
+    for(uint8_t i = 0; i < this->numPendingAllocations; i++) {
+        if(this->pendingAllocations[i].superframeID == superframeID && this->pendingAllocations[i].proposedSlots.get(slotID)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void GTSHelper::releasePendingAllocation(uint16_t address, Direction direction, uint16_t superframeID) {
+    /* The confirm only tells the superframe, and a late reply to a timed out request is confirmed to the next request to
+     * that neighbor. So the request for the same superframe is released if there is one, the oldest to the neighbor otherwise. */
+    DSME_ATOMIC_BLOCK {
+        int8_t release = -1;
+        for(uint8_t i = 0; i < this->numPendingAllocations; i++) {
+            const PendingAllocation& pending = this->pendingAllocations[i];
+            if(pending.address == address && pending.direction == direction) {
+                if(pending.superframeID == superframeID) {
+                    release = i;
+                    break;
+                } else if(release < 0) {
+                    release = i;
+                }
+            }
+        }
+
+        if(release >= 0) {
+            /* '-> keep the order, so the oldest request stays in front */
+            uint8_t kept = 0;
+            for(uint8_t i = 0; i < this->numPendingAllocations; i++) {
+                if(i != release) {
+                    if(kept != i) {
+                        this->pendingAllocations[kept] = this->pendingAllocations[i];
+                    }
+                    kept++;
+                }
+            }
+            this->numPendingAllocations = kept;
+        }
+    }
+}
+
+void GTSHelper::expirePendingAllocations() {
+    /* The GTSManager gives up on a request macResponseWaitTime after it was sent and confirms it, but the request may wait in
+     * the CAP queue for several times as long before. So only an entry that is still pending after eight times that time has
+     * lost its confirm and would block its slots forever. */
+    uint32_t responseWaitTime = this->dsmeAdaptionLayer.getMAC_PIB().macResponseWaitTime;
+    uint8_t superframeOrder = this->dsmeAdaptionLayer.getMAC_PIB().macSuperframeOrder;
+
+    uint8_t expired = 0;
+    DSME_ATOMIC_BLOCK {
+        uint8_t kept = 0;
+        for(uint8_t i = 0; i < this->numPendingAllocations; i++) {
+            PendingAllocation& pending = this->pendingAllocations[i];
+            pending.superframesPending++;
+            if(((uint32_t)pending.superframesPending << superframeOrder) > 8 * responseWaitTime) {
+                expired++;
+            } else {
+                if(kept != i) {
+                    this->pendingAllocations[kept] = pending;
+                }
+                kept++;
+            }
+        }
+        this->numPendingAllocations = kept;
+    }
+
+    if(expired > 0) {
+        LOG_INFO((uint16_t)expired << " GTS allocation(s) expired without confirm.");
+    }
 }
 
 void GTSHelper::checkAndDeallocateSingeleGTS(uint16_t address) {
     DSMEAllocationCounterTable& act = this->dsmeAdaptionLayer.getMAC_PIB().macDSMEACT;
     int16_t highestIdleCounter = -1;
     DSMEAllocationCounterTable::iterator toDeallocate = act.end();
-    for(auto it = act.begin(); it != act.end(); ++it) {
-        if(it->getDirection() == Direction::TX && it->getAddress() == address) {
-            if(it->getState() == ACTState::VALID && it->getIdleCounter() > highestIdleCounter) {
-                highestIdleCounter = it->getIdleCounter();
-                toDeallocate = it;
-            }
+    for(auto it = act.beginNeighbor(address, Direction::TX); it != act.end(); ++it) {
+        if(it->getState() == ACTState::VALID && it->getIdleCounter() > highestIdleCounter) {
+            highestIdleCounter = it->getIdleCounter();
+            toDeallocate = it;
         }
     }
 
@@ -283,7 +418,7 @@ void GTSHelper::handleDSME_GTS_indication(mlme_sap::DSME_GTS_indication_paramete
         }
         case EXPIRATION:
             // In this implementation EXPIRATION is only issued while no confirm is pending
-            // DSME_ASSERT(!gtsConfirmPending);
+            // DSME_ASSERT(numPendingAllocations == 0);
 
             // TODO is this required?
             // this->dsmeAdaptionLayer.getMAC_PIB().macDSMEACT.setACTState(params.dsmeSABSpecification, DEALLOCATED);
@@ -353,12 +488,14 @@ void GTSHelper::handleDSME_GTS_confirm(mlme_sap::DSME_GTS_confirm_parameters& pa
     // TODO handle channel access failure! retransmission?
 
     if(params.managementType == ManagementType::ALLOCATION) {
-        gtsConfirmPending = false;
-        LOG_DEBUG("gtsConfirmPending = false");
+        releasePendingAllocation(params.deviceAddress, params.direction, params.dsmeSabSpecification.getSubBlockIndex());
+        LOG_DEBUG("numPendingAllocations = " << (uint16_t)numPendingAllocations);
         if(params.status == GTSStatus::SUCCESS) {
             this->dsmeAdaptionLayer.getMessageHelper().sendRetryBuffer();
         }
         if(params.status != GTSStatus::TRANSACTION_OVERFLOW) {
+            this->lastAllocationFailed = (params.status != GTSStatus::SUCCESS);
+            /* '-> only one, the GTSManager is still busy with the confirmed handshake and would pass further requests to the same FSM */
             performSchedulingAction(this->gtsScheduling->getNextSchedulingAction());
         }
     }
@@ -395,7 +532,9 @@ GTS GTSHelper::getNextFreeGTS(uint16_t initialSuperframeID, uint8_t initialSlotI
         uint8_t numGTSlots = this->dsmeAdaptionLayer.getMAC_PIB().helper.getNumGTSlots(gts.superframeID);
         LOG_INFO("Checking " << numGTSlots << " in superframe " << gts.superframeID);
         for(gts.slotID = initialSlotID % numGTSlots; slotsToCheck > 0; gts.slotID = (gts.slotID + 1) % numGTSlots) {
-            if(!macDSMEACT.isAllocated(gts.superframeID, gts.slotID)) {
+            /* the reservations of pending requests only steer the own requests, the responder path (sabSpec given) ignores
+             * them, as otherwise a pending request would deny every neighbor a slot in its superframe */
+            if(!macDSMEACT.isAllocated(gts.superframeID, gts.slotID) && (sabSpec != nullptr || !isTentativelyReserved(gts.superframeID, gts.slotID))) {
                 uint8_t startChannel = this->dsmeAdaptionLayer.getDSME().getPlatform().getRandom() % numChannels;
                 macDSMESAB.getOccupiedChannels(occupied, gts.superframeID, gts.slotID);
                 if(sabSpec != nullptr) {
@@ -436,13 +575,12 @@ GTSStatus::GTS_Status GTSHelper::verifyDeallocation(DSMESABSpecification& reques
     bool foundGts = false;
     bool gtsDifferentAddresses = false;
 
-    for(DSMEAllocationCounterTable::iterator it = macDSMEACT.begin(); it != macDSMEACT.end(); ++it) {
-        abs_slot_idx_t idx = it->getGTSlotID();
-        idx *= numChannels;
-        idx += it->getChannel();
-
-        if(it->getSuperframeID() != requestSABSpec.getSubBlockIndex() || !requestSABSpec.getSubBlock().get(idx)) {
-            continue; // no deallocation requested
+    // only the slots requested for deallocation have to be looked up
+    for(DSMESABSpecification::SABSubBlock::iterator bit = requestSABSpec.getSubBlock().beginSetBits(); bit != requestSABSpec.getSubBlock().endSetBits();
+        ++bit) {
+        DSMEAllocationCounterTable::iterator it = macDSMEACT.find(requestSABSpec.getSubBlockIndex(), (*bit) / numChannels);
+        if(it == macDSMEACT.end() || it->getChannel() != (*bit) % numChannels) {
+            continue; // not allocated
         }
 
         if(deviceAddress == IEEE802154MacAddress::NO_SHORT_ADDRESS) {
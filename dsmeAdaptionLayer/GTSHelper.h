@@ -45,11 +45,18 @@
 
 #include "../mac_services/DSME_Common.h"
 #include "../mac_services/dataStructures/DSMEAllocationCounterTable.h"
+#include "../mac_services/dataStructures/DSMEBitVector.h"
 #include "../mac_services/dataStructures/DSMESABSpecification.h"
 #include "../mac_services/dataStructures/GTS.h"
 #include "../mac_services/dataStructures/IEEE802154MacAddress.h"
 #include "./scheduling/GTSScheduling.h"
 
+/* The number of GTS allocation requests that may wait for their confirm at the same time. More than one are only issued
+ * while the CAP queue is empty and the last allocation succeeded. */
+#if !defined(DSME_MAX_PENDING_GTS_ALLOCATIONS)
+#define DSME_MAX_PENDING_GTS_ALLOCATIONS 2
+#endif
+
 namespace dsme {
 
 class DSMEAdaptionLayer;
@@ -77,6 +84,11 @@ public:
 
     void handleStartOfCFP();
 
+    /**
+     * @return The number of slots requested from the given neighbor that are not confirmed yet
+     */
+    uint8_t getNumPendingAllocations(uint16_t address, Direction direction) const;
+
 private:
     /* MLME handlers */
 
@@ -88,9 +100,17 @@ private:
 
     /* Helper methods */
 
-    void performSchedulingAction(GTSSchedulingDecision decision);
+    bool performSchedulingAction(GTSSchedulingDecision decision);
+
+    void performSchedulingActions();
+
+    bool checkAndAllocateGTS(GTSSchedulingDecision decision);
+
+    bool isTentativelyReserved(uint16_t superframeID, uint16_t slotID) const;
+
+    void releasePendingAllocation(uint16_t address, Direction direction, uint16_t superframeID);
 
-    void checkAndAllocateGTS(GTSSchedulingDecision decision);
+    void expirePendingAllocations();
 
     void checkAndDeallocateSingeleGTS(uint16_t address);
 
@@ -112,7 +132,23 @@ private:
 
     GTSScheduling* gtsScheduling = nullptr;
 
-    bool gtsConfirmPending;
+    /**
+     * An allocation request waiting for its confirm. The responder may grant any slot the SAB specification of the request
+     * leaves free, so until then all of these slots are reserved in all channels and further own requests are steered to
+     * other slots. Requests of neighbors handled by findFreeSlots are not, see getNextFreeGTS. If no confirm arrives, the
+     * entry expires.
+     */
+    struct PendingAllocation {
+        uint16_t address;
+        Direction direction;
+        uint16_t superframeID;
+        BitVector<MAX_GTSLOTS> proposedSlots;
+        uint16_t superframesPending;
+    };
+
+    PendingAllocation pendingAllocations[DSME_MAX_PENDING_GTS_ALLOCATIONS];
+    uint8_t numPendingAllocations;
+    bool lastAllocationFailed;
 };
 
 } /* namespace dsme */
@@ -109,8 +109,9 @@ void MessageHelper::sendRetryBuffer() {
     }
 }
 
-void MessageHelper::sendMessage(IDSMEMessage* msg) {
+void MessageHelper::sendMessage(IDSMEMessage* msg, uint8_t priority) {
     LOG_INFO("Sending DATA message");
+    msg->priority = priority;
     sendMessageDown(msg, true);
 }
 
@@ -157,6 +158,7 @@ void MessageHelper::sendMessageDown(IDSMEMessage* msg, bool newMessage) {
         params.msdu = msg;
         params.msduHandle = 0; // TODO
         params.ackTx = true;
+        params.priority = msg->priority;
 
         /* TODO
         if(dsme.getDSMESettings().optimizations) {
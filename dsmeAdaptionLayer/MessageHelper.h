@@ -78,7 +78,7 @@ public:
     void setIndicationCallback(indicationCallback_t);
     void setConfirmCallback(confirmCallback_t);
 
-    void sendMessage(IDSMEMessage* msg);
+    void sendMessage(IDSMEMessage* msg, uint8_t priority);
     void sendRetryBuffer();
 
     void startAssociation();
@@ -43,6 +43,8 @@
 #ifndef GTSSCHEDULING_H_
 #define GTSSCHEDULING_H_
 
+#include "../../../dsme_platform.h"
+#include "../../../dsme_settings.h"
 #include "../../mac_services/DSME_Common.h"
 #include "../../mac_services/dataStructures/IEEE802154MacAddress.h"
 #include "../../mac_services/dataStructures/RBTree.h"
@@ -99,13 +101,16 @@ public:
     virtual GTSSchedulingDecision getNextSchedulingAction() = 0;
 
 protected:
+    /* defined out of line, the DSMEAdaptionLayer is incomplete here */
+    uint8_t getNumPendingAllocations(uint16_t address, Direction direction) const;
+
     DSMEAdaptionLayer& dsmeAdaptionLayer;
 };
 
 template <typename SchedulingData, typename RxData>
 class GTSSchedulingImpl : public GTSScheduling {
 public:
-    typedef typename RBTree<SchedulingData, uint16_t>::iterator iterator;
+    typedef typename RBTree<SchedulingData, uint16_t, MAX_NEIGHBORS>::iterator iterator;
 
     GTSSchedulingImpl(DSMEAdaptionLayer& dsmeAdaptionLayer) : GTSScheduling(dsmeAdaptionLayer) {
     }
@@ -130,7 +135,10 @@ public:
             SchedulingData data;
             data.address = address;
             data.messagesInLastMultisuperframe++;
-            this->txLinks.insert(data, address);
+            if(!this->txLinks.insert(data, address)) {
+                /* '-> already MAX_NEIGHBORS links, this one is not scheduled */
+                LOG_ERROR("No room to schedule the link to 0x" << HEXOUT << address << DECOUT << ".");
+            }
         } else {
             it->messagesInLastMultisuperframe++;
         }
@@ -153,7 +161,10 @@ public:
             RxData data;
             data.address = address;
             data.messagesRxLastMultisuperframe++;
-            this->rxLinks.insert(data, address);
+            if(!this->rxLinks.insert(data, address)) {
+                /* '-> already MAX_NEIGHBORS links, this one is not accounted */
+                LOG_ERROR("No room to account the link from 0x" << HEXOUT << address << DECOUT << ".");
+            }
         } else {
             it->messagesRxLastMultisuperframe++;
         }
@@ -161,6 +172,10 @@ public:
 
     virtual int16_t getSlotTarget(uint16_t address) {
         iterator it = this->txLinks.find(address);
+        if(it == this->txLinks.end()) {
+            /* '-> unknown link, e.g. if there was no room for it */
+            return 0;
+        }
 
         return it->slotTarget;
     }
@@ -177,7 +192,8 @@ public:
         uint16_t address = IEEE802154MacAddress::NO_SHORT_ADDRESS;
         int16_t difference = 0;
         for(const SchedulingData& d : this->txLinks) {
-            uint16_t slots = this->dsmeAdaptionLayer.getMAC_PIB().macDSMEACT.getNumAllocatedGTS(d.address, Direction::TX);
+            uint16_t slots = this->dsmeAdaptionLayer.getMAC_PIB().macDSMEACT.getNumAllocatedGTS(d.address, Direction::TX) +
+                             this->getNumPendingAllocations(d.address, Direction::TX);
 
             if(abs(difference) < abs(d.slotTarget - slots)) {
                 difference = d.slotTarget - slots;
@@ -189,10 +205,11 @@ public:
 
     virtual GTSSchedulingDecision getNextSchedulingAction(uint16_t address) {
         uint16_t numAllocatedSlots = this->dsmeAdaptionLayer.getMAC_PIB().macDSMEACT.getNumAllocatedGTS(address, Direction::TX);
+        uint8_t numPendingSlots = this->getNumPendingAllocations(address, Direction::TX);
 
         int16_t target = getSlotTarget(address);
 
-        if(target > numAllocatedSlots) {
+        if(target > numAllocatedSlots + numPendingSlots) {
             uint8_t numSuperFramesPerMultiSuperframe = this->dsmeAdaptionLayer.getMAC_PIB().helper.getNumberSuperframesPerMultiSuperframe();
             uint8_t randomSuperframeID = this->dsmeAdaptionLayer.getRandom() % numSuperFramesPerMultiSuperframe;
 
@@ -218,8 +235,8 @@ public:
     }
 
 protected:
-    RBTree<SchedulingData, uint16_t> txLinks;
-    RBTree<RxData, uint16_t> rxLinks;
+    RBTree<SchedulingData, uint16_t, MAX_NEIGHBORS> txLinks;
+    RBTree<RxData, uint16_t, MAX_NEIGHBORS> rxLinks;
     uint8_t queueLevel = 0;
 };
 
@@ -45,6 +45,7 @@
 
 #include "./StaticScheduling.h"
 
+#include <algorithm>
 #include "../../../dsme_platform.h"
 #include "../../dsmeLayer/DSMELayer.h"
 #include "../../mac_services/dataStructures/IEEE802154MacAddress.h"
@@ -70,6 +70,12 @@ void DSMEEventDispatcher::timerInterrupt() {
     DSMETimerMultiplexer::_timerInterrupt();
 }
 
+void DSMEEventDispatcher::clearLatenessHistograms() {
+    DSME_ATOMIC_BLOCK {
+        DSMETimerMultiplexer::_clearLatenessHistograms();
+    }
+}
+
 /********** Event Handlers **********/
 
 void DSMEEventDispatcher::firePreSlotTimer(int32_t lateness) {
@@ -99,7 +105,9 @@ uint32_t DSMEEventDispatcher::setupSlotTimer(uint32_t lastSlotTime, uint8_t skip
     uint32_t next_slot_time = lastSlotTime + (1 + skippedSlots) * symbols_per_slot;
 
     DSME_ATOMIC_BLOCK {
-        if(next_slot_time - PRE_EVENT_SHIFT <= NOW + 1) {
+        /* after an overload the last slot may lie several slots back, continue with the first one still ahead */
+        uint32_t now = NOW;
+        while(!isDeadlineBefore(now + 1, next_slot_time - PRE_EVENT_SHIFT)) {
             next_slot_time += symbols_per_slot;
         }
         DSMETimerMultiplexer::_startTimer<NEXT_SLOT>(next_slot_time, &DSMEEventDispatcher::fireSlotTimer);
@@ -45,6 +45,7 @@
 
 #include "../helper/Integers.h"
 #include "../interfaces/IDSMEPlatform.h"
+#include "./LatenessHistogram.h"
 #include "./TimerAbstractions.h"
 #include "./TimerMultiplexer.h"
 
@@ -64,7 +65,7 @@ enum EventTimers {
 
 class DSMEEventDispatcher;
 
-typedef TimerMultiplexer<EventTimers, DSMEEventDispatcher, IDSMEPlatform, IDSMEPlatform> DSMETimerMultiplexer;
+typedef TimerMultiplexer<EventTimers, DSMEEventDispatcher, IDSMEPlatform, IDSMEPlatform, TimerHeapQueue<TIMER_COUNT>> DSMETimerMultiplexer;
 
 class DSMEEventDispatcher : private DSMETimerMultiplexer {
 public:
@@ -85,6 +86,14 @@ public:
     void setupIFSTimer(bool LIFS);
     void stopIFSTimer();
 
+    /*! Lateness of the dispatches of \p timer since startup or the last call to clearLatenessHistograms().
+     */
+    const LatenessHistogram& getLatenessHistogram(EventTimers timer) const {
+        return DSMETimerMultiplexer::_getLatenessHistogram(timer);
+    }
+
+    void clearLatenessHistograms();
+
 private:
     DSMELayer& dsme;
 
@@ -103,9 +112,11 @@ public:
         for(uint8_t i = 0; i < EventTimers::TIMER_COUNT; ++i) {
             LOG_ERROR_PREFIX;
             LOG_ERROR_PURE(static_cast<uint16_t>(i) << ": ");
-            for(uint16_t j = 0; j < BIN_COUNT; ++j) {
-                LOG_ERROR_PURE(this->lateness_histogram[i][j] << ",");
+            const LatenessHistogram& histogram = getLatenessHistogram(static_cast<EventTimers>(i));
+            for(uint8_t j = 0; j < LatenessHistogram::NUM_BUCKETS; ++j) {
+                LOG_ERROR_PURE(histogram.getBucketCount(j) << ",");
             }
+            LOG_ERROR_PURE(" max " << histogram.getMax());
             LOG_ERROR_PURE(LOG_ENDL);
         }
         return;
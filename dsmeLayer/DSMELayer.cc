@@ -77,7 +77,13 @@ DSMELayer::DSMELayer()
       nextMultiSuperframe(0),
       trackingBeacons(false),
       nextSlotTime(0),
-      resetPending(false) {
+      resetPending(false),
+      ticklessSlotTimer(false),
+      currentSlotTime(0),
+      currentSkippedSlots(0),
+      currentSkippedSlotsRevision(0),
+      numMissedSlotDeadlines(0),
+      overloaded(false) {
 }
 
 void DSMELayer::initialize(IDSMEPlatform* platform) {
@@ -151,6 +157,9 @@ void DSMELayer::doReset() {
         this->currentMultiSuperframe = 0;
 
         this->trackingBeacons = false;
+        this->overloaded = false;
+
+        this->deferredTasks.clear();
     }
 
     /* restart slot timer */
@@ -169,22 +178,25 @@ void DSMELayer::preSlotEvent(void) {
         return;
     }
 
-    // calculate time within next slot
-    uint32_t cnt = platform->getSymbolCounter() - beaconManager.getLastKnownBeaconIntervalStart() + PRE_EVENT_SHIFT + 1;
-
-    // calculate slot position
-    uint16_t slotsSinceLastKnownBeaconIntervalStart = cnt / getMAC_PIB().helper.getSymbolsPerSlot();
-    nextSlot = slotsSinceLastKnownBeaconIntervalStart % aNumSuperframeSlots;
-    uint16_t superframe = slotsSinceLastKnownBeaconIntervalStart / aNumSuperframeSlots;
-    nextSuperframe = superframe % getMAC_PIB().helper.getNumberSuperframesPerMultiSuperframe();
-    superframe /= getMAC_PIB().helper.getNumberSuperframesPerMultiSuperframe();
-    nextMultiSuperframe = superframe % getMAC_PIB().helper.getNumberMultiSuperframesPerBeaconInterval();
+    // calculate position of the next slot
+    if(this->trackingBeacons) {
+        updateSlotPosition(platform->getSymbolCounter() + PRE_EVENT_SHIFT + 1);
+    } else {
+        /* '-> the own slot timer defines the slots, so a late pre-slot event must not move on to a later slot */
+        updateSlotPosition(this->nextSlotTime + 1);
+    }
+    nextSlot = slotPosition.getSlot();
+    nextSuperframe = slotPosition.getSuperframe();
+    nextMultiSuperframe = slotPosition.getMultiSuperframe();
 
     if(nextSlot == 0) {
         beaconManager.preSuperframeEvent(nextSuperframe, nextMultiSuperframe, nextSlotTime);
     }
 
-    messageDispatcher.handlePreSlotEvent(nextSlot, nextSuperframe, nextMultiSuperframe);
+    if(!messageDispatcher.handlePreSlotEvent(nextSlot, nextSuperframe, nextMultiSuperframe)) {
+        /* '-> the previous GTS is still busy, e.g. because its ACK timer fired late, so the next slot is lost */
+        missSlotDeadlines(1);
+    }
 }
 
 void DSMELayer::slotEvent(int32_t lateness) {
@@ -201,24 +213,31 @@ void DSMELayer::slotEvent(int32_t lateness) {
         LOG_DEBUG(DECOUT << currentSlot << " " << currentSuperframe << " " << currentMultiSuperframe);
     }
 
-    if(lateness > 100) { // TODO reduce
-        LOG_ERROR("lateness " << lateness);
-        DSME_ASSERT(false);
+    bool missed = (lateness > MAX_SLOT_LATENESS);
+    if(missed) {
+        /* '-> shed the slot instead of serving it out of time, the slot timer continues with the next slot ahead */
+        LOG_DEBUG("lateness " << lateness);
+        missSlotDeadlines(1 + lateness / getMAC_PIB().helper.getSymbolsPerSlot());
+    } else if(currentSlot == 0) {
+        /* '-> resynchronized by the beacon slot */
+        this->overloaded = false;
     }
 
-    uint32_t currentSlotTime;
-
-    // TODO set timer to next relevant slot only!
-    // TODO in that case currentSlot might be used even if no slotEvent was called before -> calculate then
+    // the slot position is calculated from the beacon interval start in preSlotEvent, so slots may be skipped
     if(this->trackingBeacons) {
-        auto now = platform->getSymbolCounter();
-        currentSlotTime = now - (now - beaconManager.getLastKnownBeaconIntervalStart()) % getMAC_PIB().helper.getSymbolsPerSlot();
+        updateSlotPosition(platform->getSymbolCounter());
+        currentSlotTime = slotPosition.getSlotStart();
     } else {
         currentSlotTime = this->nextSlotTime;
     }
 
     uint8_t skippedSlots = 0;
-    if(currentSlot == 1) { // beginning of CAP
+    if(missed) {
+        /* '-> currentSlot may already lie behind, tick every slot until resynchronized */
+        skippedSlots = 0;
+    } else if(this->ticklessSlotTimer && this->mac_pib->macAssociatedPANCoord) {
+        skippedSlots = getNumIdleSlotsAfter(currentSlot, currentSuperframe);
+    } else if(currentSlot == 1) { // beginning of CAP
         if(this->mac_pib->macCapReduction && currentSuperframe > 0) {
             // no CAP available
             skippedSlots = 0;
@@ -228,6 +247,8 @@ void DSMELayer::slotEvent(int32_t lateness) {
         }
     }
 
+    this->currentSkippedSlots = skippedSlots;
+    this->currentSkippedSlotsRevision = getMAC_PIB().macDSMEACT.getRevision();
     this->nextSlotTime = eventDispatcher.setupSlotTimer(currentSlotTime, skippedSlots);
 
     /* handle slot */
@@ -235,7 +256,11 @@ void DSMELayer::slotEvent(int32_t lateness) {
         beaconManager.superframeEvent(lateness, currentSlotTime);
     }
 
-    messageDispatcher.handleSlotEvent(currentSlot, currentSuperframe, lateness);
+    if(missed) {
+        messageDispatcher.handleMissedSlot(currentSlot, currentSuperframe);
+    } else {
+        messageDispatcher.handleSlotEvent(currentSlot, currentSuperframe, lateness);
+    }
 
     if(currentSlot == getMAC_PIB().helper.getFinalCAPSlot(currentSuperframe) + 1) {
         platform->scheduleStartOfCFP();
@@ -243,23 +268,111 @@ void DSMELayer::slotEvent(int32_t lateness) {
 }
 
 void DSMELayer::handleStartOfCFP() {
+    /* scheduling and statistics are not bound to the slot timing, they are useless after the end of this superframe */
+    uint32_t endOfSuperframe = this->currentSlotTime + (aNumSuperframeSlots - this->currentSlot) * getMAC_PIB().helper.getSymbolsPerSlot();
+
+    if(!this->overloaded) {
+        /* '-> statistics and GTS scheduling are skipped for this superframe while overloaded */
 #ifdef STATISTICS_MONITOR_LATENESS
-    if(latenessStatisticsCount++ % 10 == 0) {
-        this->eventDispatcher.printLatenessHistogram();
-    }
+        if(latenessStatisticsCount++ % 10 == 0) {
+            this->eventDispatcher.printLatenessHistogram();
+        }
 #endif
 
-    if(this->startOfCFPDelegate) {
-        this->startOfCFPDelegate();
+        if(this->startOfCFPDelegate) {
+            deferTask(this->startOfCFPDelegate, TASK_PRIORITY_NORMAL, endOfSuperframe);
+        }
     }
 
-    this->capLayer.handleStartOfCFP();
+    deferTask(DELEGATE(&CAPLayer::handleStartOfCFP, this->capLayer), TASK_PRIORITY_LOW, endOfSuperframe);
     this->gtsManager.handleStartOfCFP(this->currentSuperframe);
     this->associationManager.handleStartOfCFP(this->currentSuperframe);
     this->beaconManager.handleStartOfCFP(this->currentSuperframe, this->currentMultiSuperframe);
+
+    if(this->currentSkippedSlots > 0 && this->currentSkippedSlotsRevision != getMAC_PIB().macDSMEACT.getRevision()) {
+        /* '-> slots were allocated after the slot timer skipped them */
+        uint8_t skippedSlots = getNumIdleSlotsAfter(this->currentSlot, this->currentSuperframe);
+        if(skippedSlots < this->currentSkippedSlots) {
+            this->currentSkippedSlots = skippedSlots;
+            this->nextSlotTime = eventDispatcher.setupSlotTimer(this->currentSlotTime, skippedSlots);
+        }
+        this->currentSkippedSlotsRevision = getMAC_PIB().macDSMEACT.getRevision();
+    }
+}
+
+void DSMELayer::deferTask(Delegate<void()> task, DeferredTaskPriority priority, uint32_t deadline) {
+    if(!this->deferredTasks.post(task, priority, deadline)) {
+        /* '-> rather late than never */
+        task();
+        return;
+    }
+
+    if(!this->platform->scheduleDeferredTasks()) {
+        runDeferredTasks();
+    }
+}
+
+void DSMELayer::runDeferredTasks() {
+    /* the time is read for every task, since the previous one may have taken a while */
+    while(this->deferredTasks.runNext(this->platform->getSymbolCounter())) {
+    }
+}
+
+void DSMELayer::missSlotDeadlines(uint32_t numSlots) {
+    this->numMissedSlotDeadlines += numSlots;
+    if(!this->overloaded) {
+        LOG_ERROR("missed " << numSlots << " slot deadline(s), shedding load until the next beacon");
+        this->overloaded = true;
+    }
+}
+
+uint8_t DSMELayer::getNumIdleSlotsAfter(uint16_t slot, uint16_t superframe) {
+    DSMEAllocationCounterTable& act = getMAC_PIB().macDSMEACT;
+    uint8_t finalCAPSlot = getMAC_PIB().helper.getFinalCAPSlot(superframe);
+
+    if(slot > finalCAPSlot && act.isAllocated(superframe, slot - (finalCAPSlot + 1))) {
+        /* '-> the next pre-slot event finishes this GTS */
+        return 0;
+    }
+
+    // the beacon slot of the next superframe always has work
+    uint16_t next = slot + 1;
+    while(next < aNumSuperframeSlots) {
+        if(next == 1 || next == finalCAPSlot + 1) {
+            /* '-> start of the CAP or the CFP */
+            break;
+        }
+        if(next > finalCAPSlot && act.isAllocated(superframe, next - (finalCAPSlot + 1))) {
+            break;
+        }
+        next++;
+    }
+    return next - slot - 1;
+}
+
+void DSMELayer::updateSlotPosition(uint32_t time) {
+    slotPosition.advanceTo(time, beaconManager.getLastKnownBeaconIntervalStart(), mac_pib->macSuperframeOrder, mac_pib->macMultiSuperframeOrder,
+                           mac_pib->macBeaconOrder);
+}
+
+bool DSMELayer::isSlotPositionSynchronized() const {
+    return slotPosition.isSynchronizedWith(beaconManager.getLastKnownBeaconIntervalStart(), mac_pib->macSuperframeOrder, mac_pib->macMultiSuperframeOrder,
+                                           mac_pib->macBeaconOrder);
 }
 
 uint32_t DSMELayer::getSymbolsSinceCapFrameStart(uint32_t time) {
+    uint32_t symbols;
+    if(isSlotPositionSynchronized()) {
+        if(this->mac_pib->macCapReduction) {
+            if(slotPosition.getSymbolsSinceMultiSuperframeStart(time, symbols)) {
+                return symbols;
+            }
+        } else if(slotPosition.getSymbolsSinceSuperframeStart(time, symbols)) {
+            return symbols;
+        }
+    }
+
+    /* '-> time is outside of the tracked (multi-)superframe */
     uint32_t symbolsSinceLastBeaconInterval = time - this->beaconManager.getLastKnownBeaconIntervalStart();
 
     if(this->mac_pib->macCapReduction) {
@@ -287,12 +400,19 @@ bool DSMELayer::isWithinCAP(uint32_t time, uint16_t duration) {
 
 bool DSMELayer::isWithinTimeSlot(uint32_t now, uint16_t duration) {
     uint32_t symbolsPerSlot = getMAC_PIB().helper.getSymbolsPerSlot();
-    uint32_t symbolsSinceLastBeaconInterval = now - this->beaconManager.getLastKnownBeaconIntervalStart();
 
-    uint32_t timeSlotStart = (symbolsSinceLastBeaconInterval / symbolsPerSlot) * symbolsPerSlot + this->beaconManager.getLastKnownBeaconIntervalStart();
+    uint32_t timeSlotStart;
+    if(!isSlotPositionSynchronized() || !slotPosition.getStartOfSlot(now, timeSlotStart)) {
+        uint32_t symbolsSinceLastBeaconInterval = now - this->beaconManager.getLastKnownBeaconIntervalStart();
+        timeSlotStart = (symbolsSinceLastBeaconInterval / symbolsPerSlot) * symbolsPerSlot + this->beaconManager.getLastKnownBeaconIntervalStart();
+    }
     uint32_t timeSlotEnd = timeSlotStart + symbolsPerSlot - PRE_EVENT_SHIFT;
 
-    DSME_ASSERT(now >= timeSlotStart && now <= timeSlotEnd);
+    DSME_ASSERT(now >= timeSlotStart);
+    if(now > timeSlotEnd) {
+        /* '-> already in the pre-slot window of the next slot, e.g. after a late IFS timer */
+        return false;
+    }
     LOG_DEBUG("Checking isWithingTimeSlot: slot start time (" << timeSlotStart << ") <= current time (" << now << ") <= duration ("
         << now+duration << ") <= slot end time (" << timeSlotEnd << ")");
 
@@ -304,6 +424,10 @@ void DSMELayer::startTrackingBeacons() {
     return;
 }
 
+void DSMELayer::setTicklessSlotTimer(bool tickless) {
+    this->ticklessSlotTimer = tickless;
+}
+
 void DSMELayer::stopTrackingBeacons() {
     this->trackingBeacons = false;
     return;
@@ -50,6 +50,8 @@
 #include "../interfaces/IDSMEMessage.h"
 #include "../interfaces/IDSMEPlatform.h"
 #include "./DSMEEventDispatcher.h"
+#include "./DeferredTaskQueue.h"
+#include "./SlotPositionTracker.h"
 #include "./ackLayer/AckLayer.h"
 #include "./associationManager/AssociationManager.h"
 #include "./beaconManager/BeaconManager.h"
@@ -207,7 +209,55 @@ public:
     void stopTrackingBeacons();
     bool isTrackingBeacons() const;
 
+    /**
+     * In tickless mode the slot timer of an associated device only fires for slots with work: the beacon slot,
+     * the start of the CAP and of the CFP, allocated GTS and the slot following an allocated GTS, which
+     * finishes it. Otherwise it fires for every slot outside the CAP.
+     */
+    void setTicklessSlotTimer(bool tickless);
+
+    /**
+     * Number of slots that missed their deadline since startup: a slot whose slot event came more than
+     * MAX_SLOT_LATENESS symbols late, plus every slot the late slot timer overran completely, and a GTS
+     * that could not be prepared because the previous one was still busy.
+     * The lateness of the individual timers is available from the DSMEEventDispatcher.
+     */
+    uint32_t getNumMissedSlotDeadlines() const {
+        return this->numMissedSlotDeadlines;
+    }
+
+    /**
+     * True from a missed slot deadline until the next beacon slot that is served on time. While overloaded,
+     * late slots are skipped and the scheduling work at the start of the CFP is deferred.
+     */
+    bool isOverloaded() const {
+        return this->overloaded;
+    }
+
+    static constexpr uint8_t DEFERRED_TASK_QUEUE_SIZE = 8;
+
+    /**
+     * Runs \p task later from task context, see DeferredTaskQueue. If the queue is full or the platform
+     * can not schedule deferred tasks, the task runs right away.
+     */
+    void deferTask(Delegate<void()> task, DeferredTaskPriority priority, uint32_t deadline);
+
+    /**
+     * Runs all pending deferred tasks. Called by the platform from task context, e.g. from its main
+     * loop or idle hook, after IDSMEPlatform::scheduleDeferredTasks().
+     */
+    void runDeferredTasks();
+
+    const DeferredTaskQueue<DEFERRED_TASK_QUEUE_SIZE>& getDeferredTasks() const {
+        return this->deferredTasks;
+    }
+
 protected:
+    /**
+     * Latest slot event in symbols after the start of its slot that still allows to serve the slot.
+     */
+    static constexpr int32_t MAX_SLOT_LATENESS = 100;
+
     IDSMEPlatform* platform;
     DSMEEventDispatcher eventDispatcher;
     Delegate<void()> startOfCFPDelegate;
@@ -235,11 +285,42 @@ protected:
     uint16_t nextMultiSuperframe;
 
     bool trackingBeacons;
+    SlotPositionTracker slotPosition;
     uint32_t nextSlotTime;
     bool resetPending;
 
+    bool ticklessSlotTimer;
+    uint32_t currentSlotTime;
+    uint8_t currentSkippedSlots;
+    uint16_t currentSkippedSlotsRevision;
+
+    uint32_t numMissedSlotDeadlines;
+    bool overloaded;
+
+    DeferredTaskQueue<DEFERRED_TASK_QUEUE_SIZE> deferredTasks;
+
     void doReset();
 
+    /**
+     * Moves the slot position to the slot that contains time.
+     */
+    void updateSlotPosition(uint32_t time);
+
+    /**
+     * True if the slot position refers to the current beacon interval and orders.
+     */
+    bool isSlotPositionSynchronized() const;
+
+    /**
+     * Accounts slots that could not be served and enters the overloaded state.
+     */
+    void missSlotDeadlines(uint32_t numSlots);
+
+    /**
+     * Number of slots after the given one that need neither a pre-slot nor a slot event.
+     */
+    uint8_t getNumIdleSlotsAfter(uint16_t slot, uint16_t superframe);
+
     /**
      * Called every slot to display node status in GUI
      * TODO currently platform specific!
@@ -0,0 +1,184 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef DEFERREDTASKQUEUE_H_
+#define DEFERREDTASKQUEUE_H_
+
+#include "../../dsme_platform.h"
+#include "../helper/DSMEAtomic.h"
+#include "../helper/DSMEDelegate.h"
+#include "../helper/Integers.h"
+#include "./TimerQueue.h"
+
+namespace dsme {
+
+enum DeferredTaskPriority { TASK_PRIORITY_HIGH, TASK_PRIORITY_NORMAL, TASK_PRIORITY_LOW };
+
+/**
+ * Bounded queue of work that does not have to be done in the timer or radio event context, like GTS
+ * scheduling and statistics. Tasks are posted from any context and run from task context, the most
+ * urgent first: by priority, and by deadline within a priority. A task whose deadline has passed when it
+ * is due is discarded, the deadline is the last point in time at which running the task is still useful.
+ *
+ * The queue holds only a handful of tasks, so it is a plain array that is searched for the next task.
+ */
+template <uint8_t N>
+class DeferredTaskQueue {
+public:
+    typedef Delegate<void()> task_t;
+
+    DeferredTaskQueue() : numPending(0), numOverflows(0), numExpired(0) {
+        for(uint8_t i = 0; i < N; i++) {
+            this->tasks[i].pending = false;
+        }
+    }
+
+    /**
+     * Queues \p task, which should run no later than \p deadline (in symbols).
+     * \return false if the queue is full, the task is then not queued
+     */
+    bool post(task_t task, DeferredTaskPriority priority, uint32_t deadline) {
+        bool posted = false;
+        DSME_ATOMIC_BLOCK {
+            for(uint8_t i = 0; i < N; i++) {
+                if(!this->tasks[i].pending) {
+                    this->tasks[i].task = task;
+                    this->tasks[i].deadline = deadline;
+                    this->tasks[i].priority = priority;
+                    this->tasks[i].pending = true;
+                    this->numPending++;
+                    posted = true;
+                    break;
+                }
+            }
+            if(!posted) {
+                this->numOverflows++;
+            }
+        }
+        return posted;
+    }
+
+    /**
+     * Runs the most urgent pending task, discarding the expired ones on the way.
+     * \return false if no task was run
+     */
+    bool runNext(uint32_t now) {
+        task_t task;
+        DSME_ATOMIC_BLOCK {
+            while(this->numPending > 0) {
+                uint8_t next = findMostUrgent();
+                this->tasks[next].pending = false;
+                this->numPending--;
+                if(isDeadlineBefore(this->tasks[next].deadline, now)) {
+                    this->numExpired++;
+                } else {
+                    task = this->tasks[next].task;
+                    break;
+                }
+            }
+        }
+
+        if(!task) {
+            return false;
+        }
+        task();
+        return true;
+    }
+
+    /**
+     * Discards all pending tasks, e.g. on a reset of the layer that posted them.
+     */
+    void clear() {
+        DSME_ATOMIC_BLOCK {
+            for(uint8_t i = 0; i < N; i++) {
+                this->tasks[i].pending = false;
+            }
+            this->numPending = 0;
+        }
+    }
+
+    bool isEmpty() const {
+        return this->numPending == 0;
+    }
+
+    /** Number of tasks that could not be posted because the queue was full. */
+    uint32_t getNumOverflows() const {
+        return this->numOverflows;
+    }
+
+    /** Number of tasks discarded because they were not run before their deadline. */
+    uint32_t getNumExpired() const {
+        return this->numExpired;
+    }
+
+private:
+    struct Entry {
+        task_t task;
+        uint32_t deadline;
+        DeferredTaskPriority priority;
+        bool pending;
+    };
+
+    /* assumes at least one pending task */
+    uint8_t findMostUrgent() const {
+        uint8_t next = N;
+        for(uint8_t i = 0; i < N; i++) {
+            if(!this->tasks[i].pending) {
+                continue;
+            }
+            if(next == N || this->tasks[i].priority < this->tasks[next].priority ||
+               (this->tasks[i].priority == this->tasks[next].priority && isDeadlineBefore(this->tasks[i].deadline, this->tasks[next].deadline))) {
+                next = i;
+            }
+        }
+        return next;
+    }
+
+    Entry tasks[N];
+    uint8_t numPending;
+    uint32_t numOverflows;
+    uint32_t numExpired;
+};
+
+} /* namespace dsme */
+
+#endif /* DEFERREDTASKQUEUE_H_ */
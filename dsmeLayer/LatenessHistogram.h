@@ -0,0 +1,140 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef LATENESSHISTOGRAM_H_
+#define LATENESSHISTOGRAM_H_
+
+#include "../helper/BitOperations.h"
+#include "../helper/Integers.h"
+
+namespace dsme {
+
+/**
+ * Histogram of timer lateness in symbols with logarithmic buckets, cheap enough to be updated on every
+ * timer dispatch. Bucket 0 counts events on time, bucket k > 0 counts a lateness of 2^(k-1) to 2^k - 1
+ * symbols and the last bucket everything from 2^(NUM_BUCKETS - 2) symbols on.
+ *
+ * The histogram is updated from the timer interrupt, read it within a DSME_ATOMIC_BLOCK to get a
+ * consistent snapshot.
+ */
+class LatenessHistogram {
+public:
+    static constexpr uint8_t NUM_BUCKETS = 16;
+
+    LatenessHistogram() {
+        clear();
+    }
+
+    void clear() {
+        for(uint8_t i = 0; i < NUM_BUCKETS; i++) {
+            this->buckets[i] = 0;
+        }
+        this->count = 0;
+        this->max = 0;
+    }
+
+    void add(uint32_t lateness) {
+        this->buckets[getBucket(lateness)]++;
+        this->count++;
+        if(lateness > this->max) {
+            this->max = lateness;
+        }
+    }
+
+    uint32_t getCount() const {
+        return this->count;
+    }
+
+    uint32_t getBucketCount(uint8_t bucket) const {
+        return this->buckets[bucket];
+    }
+
+    /** Largest lateness recorded so far. */
+    uint32_t getMax() const {
+        return this->max;
+    }
+
+    /**
+     * Upper bound of the lateness of \p percent of the recorded events, accurate to the width of a bucket.
+     * \return 0 if nothing was recorded
+     */
+    uint32_t getPercentile(uint8_t percent) const {
+        /* rank of the event that is looked up, rounded up */
+        uint64_t rank = ((uint64_t)this->count * percent + 99) / 100;
+        uint32_t seen = 0;
+        for(uint8_t i = 0; i < NUM_BUCKETS - 1; i++) {
+            seen += this->buckets[i];
+            if(seen >= rank) {
+                uint32_t upper = getBucketUpperBound(i);
+                return (upper < this->max) ? upper : this->max;
+            }
+        }
+        return this->max;
+    }
+
+    static uint8_t getBucket(uint32_t lateness) {
+        if(lateness == 0) {
+            return 0;
+        }
+        uint8_t bucket = 32 - countLeadingZeros(lateness);
+        return (bucket < NUM_BUCKETS) ? bucket : NUM_BUCKETS - 1;
+    }
+
+    /** Smallest lateness counted in \p bucket. */
+    static uint32_t getBucketLowerBound(uint8_t bucket) {
+        return (bucket == 0) ? 0 : (uint32_t)1 << (bucket - 1);
+    }
+
+    /** Largest lateness counted in \p bucket, UINT32_MAX for the last one. */
+    static uint32_t getBucketUpperBound(uint8_t bucket) {
+        return (bucket == NUM_BUCKETS - 1) ? UINT32_MAX : ((uint32_t)1 << bucket) - 1;
+    }
+
+private:
+    uint32_t buckets[NUM_BUCKETS];
+    uint32_t count;
+    uint32_t max;
+};
+
+} /* namespace dsme */
+
+#endif /* LATENESSHISTOGRAM_H_ */
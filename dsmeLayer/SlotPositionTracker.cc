@@ -0,0 +1,180 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "./SlotPositionTracker.h"
+
+#include "../mac_services/pib/dsme_mac_constants.h"
+
+namespace dsme {
+
+SlotPositionTracker::SlotPositionTracker()
+    : synchronized(false),
+      beaconIntervalStart(0),
+      superframeOrder(0),
+      multiSuperframeOrder(0),
+      beaconOrder(0),
+      symbolsPerSlot(0),
+      symbolsPerSuperframe(0),
+      symbolsPerMultiSuperframe(0),
+      symbolsPerBeaconInterval(0),
+      superframesPerMultiSuperframe(0),
+      multiSuperframesPerBeaconInterval(0),
+      slotStart(0),
+      superframeStart(0),
+      multiSuperframeStart(0),
+      slot(0),
+      superframe(0),
+      multiSuperframe(0) {
+}
+
+void SlotPositionTracker::advanceTo(uint32_t time, uint32_t beaconIntervalStart, uint8_t superframeOrder, uint8_t multiSuperframeOrder,
+                                    uint8_t beaconOrder) {
+    if(!synchronized || superframeOrder != this->superframeOrder || multiSuperframeOrder != this->multiSuperframeOrder ||
+       beaconOrder != this->beaconOrder) {
+        configure(superframeOrder, multiSuperframeOrder, beaconOrder);
+        resynchronize(time, beaconIntervalStart);
+        return;
+    }
+
+    /* also catches times before the tracked slot, since the difference wraps around */
+    uint32_t ahead = time - slotStart;
+    if(beaconIntervalStart != this->beaconIntervalStart || ahead >= symbolsPerBeaconInterval) {
+        resynchronize(time, beaconIntervalStart);
+        return;
+    }
+
+    while(ahead >= symbolsPerSlot) {
+        ahead -= symbolsPerSlot;
+        nextSlot();
+    }
+}
+
+bool SlotPositionTracker::isSynchronizedWith(uint32_t beaconIntervalStart, uint8_t superframeOrder, uint8_t multiSuperframeOrder,
+                                             uint8_t beaconOrder) const {
+    return synchronized && beaconIntervalStart == this->beaconIntervalStart && superframeOrder == this->superframeOrder &&
+           multiSuperframeOrder == this->multiSuperframeOrder && beaconOrder == this->beaconOrder;
+}
+
+bool SlotPositionTracker::getSymbolsSinceSuperframeStart(uint32_t time, uint32_t& symbols) const {
+    if(!synchronized || time - superframeStart >= symbolsPerSuperframe) {
+        return false;
+    }
+    symbols = time - superframeStart;
+    return true;
+}
+
+bool SlotPositionTracker::getSymbolsSinceMultiSuperframeStart(uint32_t time, uint32_t& symbols) const {
+    if(!synchronized || time - multiSuperframeStart >= symbolsPerMultiSuperframe) {
+        return false;
+    }
+    symbols = time - multiSuperframeStart;
+    return true;
+}
+
+bool SlotPositionTracker::getStartOfSlot(uint32_t time, uint32_t& start) const {
+    if(!synchronized) {
+        return false;
+    }
+
+    if(time - slotStart < symbolsPerSlot) {
+        start = slotStart;
+        return true;
+    } else if(slotStart - time <= symbolsPerSlot) {
+        /* '-> the pre-slot event already moved on to the next slot */
+        start = slotStart - symbolsPerSlot;
+        return true;
+    }
+    return false;
+}
+
+void SlotPositionTracker::configure(uint8_t superframeOrder, uint8_t multiSuperframeOrder, uint8_t beaconOrder) {
+    this->superframeOrder = superframeOrder;
+    this->multiSuperframeOrder = multiSuperframeOrder;
+    this->beaconOrder = beaconOrder;
+
+    symbolsPerSlot = aBaseSlotDuration * ((uint32_t)1 << superframeOrder);
+    symbolsPerSuperframe = aNumSuperframeSlots * symbolsPerSlot;
+    symbolsPerMultiSuperframe = aNumSuperframeSlots * (uint32_t)aBaseSlotDuration * ((uint32_t)1 << multiSuperframeOrder);
+    symbolsPerBeaconInterval = aNumSuperframeSlots * (uint32_t)aBaseSlotDuration * ((uint32_t)1 << beaconOrder);
+    superframesPerMultiSuperframe = 1 << (uint8_t)(multiSuperframeOrder - superframeOrder);
+    multiSuperframesPerBeaconInterval = 1 << (uint8_t)(beaconOrder - multiSuperframeOrder);
+}
+
+void SlotPositionTracker::resynchronize(uint32_t time, uint32_t beaconIntervalStart) {
+    this->beaconIntervalStart = beaconIntervalStart;
+
+    uint32_t slotsSinceBeaconIntervalStart = (time - beaconIntervalStart) / symbolsPerSlot;
+    slot = slotsSinceBeaconIntervalStart % aNumSuperframeSlots;
+    uint32_t superframes = slotsSinceBeaconIntervalStart / aNumSuperframeSlots;
+    superframe = superframes % superframesPerMultiSuperframe;
+    multiSuperframe = (superframes / superframesPerMultiSuperframe) % multiSuperframesPerBeaconInterval;
+
+    slotStart = beaconIntervalStart + slotsSinceBeaconIntervalStart * symbolsPerSlot;
+    superframeStart = slotStart - slot * symbolsPerSlot;
+    multiSuperframeStart = superframeStart - superframe * symbolsPerSuperframe;
+
+    synchronized = true;
+}
+
+void SlotPositionTracker::nextSlot() {
+    slotStart += symbolsPerSlot;
+    slot++;
+    if(slot < aNumSuperframeSlots) {
+        return;
+    }
+
+    slot = 0;
+    superframe++;
+    superframeStart = slotStart;
+    if(superframe < superframesPerMultiSuperframe) {
+        return;
+    }
+
+    superframe = 0;
+    multiSuperframe++;
+    multiSuperframeStart = slotStart;
+    if(multiSuperframe == multiSuperframesPerBeaconInterval) {
+        multiSuperframe = 0;
+    }
+}
+
+} /* namespace dsme */
@@ -0,0 +1,126 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef SLOTPOSITIONTRACKER_H_
+#define SLOTPOSITIONTRACKER_H_
+
+#include "../helper/Integers.h"
+
+namespace dsme {
+
+/**
+ * Tracks the slot, superframe and multi-superframe that contain a monotonically advancing point in time.
+ * Moving forward only needs additions and comparisons with constants that are cached per superframe,
+ * multi-superframe and beacon order. Divisions are only required to resynchronize, i.e. initially, if
+ * the orders or the start of the beacon interval change (which happens with every received beacon of a
+ * tracked coordinator) or if the tracked position falls behind by more than a beacon interval.
+ */
+class SlotPositionTracker {
+public:
+    SlotPositionTracker();
+
+    /**
+     * Moves the tracked position to the slot that contains time.
+     */
+    void advanceTo(uint32_t time, uint32_t beaconIntervalStart, uint8_t superframeOrder, uint8_t multiSuperframeOrder, uint8_t beaconOrder);
+
+    uint16_t getSlot() const {
+        return slot;
+    }
+
+    uint16_t getSuperframe() const {
+        return superframe;
+    }
+
+    uint16_t getMultiSuperframe() const {
+        return multiSuperframe;
+    }
+
+    uint32_t getSlotStart() const {
+        return slotStart;
+    }
+
+    /**
+     * True if the tracked position refers to the given beacon interval start and orders.
+     */
+    bool isSynchronizedWith(uint32_t beaconIntervalStart, uint8_t superframeOrder, uint8_t multiSuperframeOrder, uint8_t beaconOrder) const;
+
+    /*
+     * The following queries succeed without divisions if the tracker is synchronized and time lies within the
+     * tracked superframe, multi-superframe or slot (or the slot before). Otherwise they return false and the
+     * caller has to calculate the result itself.
+     */
+    bool getSymbolsSinceSuperframeStart(uint32_t time, uint32_t& symbols) const;
+    bool getSymbolsSinceMultiSuperframeStart(uint32_t time, uint32_t& symbols) const;
+    bool getStartOfSlot(uint32_t time, uint32_t& start) const;
+
+private:
+    void configure(uint8_t superframeOrder, uint8_t multiSuperframeOrder, uint8_t beaconOrder);
+    void resynchronize(uint32_t time, uint32_t beaconIntervalStart);
+    void nextSlot();
+
+    bool synchronized;
+    uint32_t beaconIntervalStart;
+    uint8_t superframeOrder;
+    uint8_t multiSuperframeOrder;
+    uint8_t beaconOrder;
+
+    /* cached per order */
+    uint32_t symbolsPerSlot;
+    uint32_t symbolsPerSuperframe;
+    uint32_t symbolsPerMultiSuperframe;
+    uint32_t symbolsPerBeaconInterval;
+    uint16_t superframesPerMultiSuperframe;
+    uint16_t multiSuperframesPerBeaconInterval;
+
+    /* tracked position */
+    uint32_t slotStart;
+    uint32_t superframeStart;
+    uint32_t multiSuperframeStart;
+    uint16_t slot;
+    uint16_t superframe;
+    uint16_t multiSuperframe;
+};
+
+} /* namespace dsme */
+
+#endif /* SLOTPOSITIONTRACKER_H_ */
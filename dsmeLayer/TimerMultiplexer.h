@@ -47,17 +47,17 @@
 #include "../helper/DSMEAtomic.h"
 #include "../helper/Integers.h"
 #include "./EventHistory.h"
+#include "./LatenessHistogram.h"
 #include "./TimerAbstractions.h"
-
-#ifdef STATISTICS_MONITOR_LATENESS
-#define BIN_COUNT (16)
-#define BIN_WIDTH (16)
-#define MAXIMUM_LATENESS_ALLOWED ((BIN_COUNT - 1) * (BIN_WIDTH))
-#endif
+#include "./TimerQueue.h"
 
 namespace dsme {
 
-template <typename T, typename R, typename G, typename S>
+/*
+ * The deadlines are kept in a deadline queue \p Q (see TimerQueue.h), so the cost of arming, stopping
+ * and finding the next timer depends on the queue and not on a scan over all timers.
+ */
+template <typename T, typename R, typename G, typename S, typename Q = TimerHeapQueue<T::TIMER_COUNT>>
 class TimerMultiplexer {
 protected:
     typedef T timer_t;
@@ -66,17 +66,8 @@ protected:
     TimerMultiplexer(R* instance, ReadonlyTimerAbstraction<G>& now, WriteonlyTimerAbstraction<S>& timer)
         : lastDispatchSymbolCounter(0), currentDispatchSymbolCounter(0), instance(instance), _NOW(now), _TIMER(timer) {
         for(uint8_t i = 0; i < timer_t::TIMER_COUNT; ++i) {
-            this->symbols_until[i] = -1;
             this->handlers[i] = nullptr;
         }
-
-#ifdef STATISTICS_MONITOR_LATENESS
-        for(uint8_t i = 0; i < timer_t::TIMER_COUNT; ++i) {
-            for(uint16_t j = 0; j < BIN_COUNT; ++j) {
-                this->lateness_histogram[i][j] = 0;
-            }
-        }
-#endif
     }
 
     void _initialize() {
@@ -88,8 +79,8 @@ protected:
         wasReset = true;
 
         this->lastDispatchSymbolCounter = _NOW;
+        this->deadlines.clear();
         for(uint8_t i = 0; i < timer_t::TIMER_COUNT; ++i) {
-            this->symbols_until[i] = -1;
             this->handlers[i] = nullptr;
         }
 
@@ -117,31 +108,36 @@ protected:
             DSME_ASSERT(false);
         }
 
-        this->symbols_until[E] = nextEventSymbolCounter - this->lastDispatchSymbolCounter;
+        this->deadlines.arm(E, nextEventSymbolCounter);
         this->handlers[E] = handler;
         return;
     }
 
+    /**
+     * The lateness of all dispatches of \p timer so far, kept across _reset().
+     */
+    const LatenessHistogram& _getLatenessHistogram(T timer) const {
+        return this->latenessHistograms[timer];
+    }
+
+    void _clearLatenessHistograms() {
+        for(uint8_t i = 0; i < timer_t::TIMER_COUNT; ++i) {
+            this->latenessHistograms[i].clear();
+        }
+    }
+
     template <T E>
     inline void _stopTimer() {
-        this->symbols_until[E] = -1;
+        this->deadlines.cancel(E);
         return;
     }
 
     void _scheduleTimer() {
-        uint32_t symsUntilNextEvent = UINT32_MAX;
-
-        for(uint8_t i = 0; i < timer_t::TIMER_COUNT; ++i) {
-            if(0 < this->symbols_until[i] && static_cast<uint32_t>(this->symbols_until[i]) < symsUntilNextEvent) {
-                symsUntilNextEvent = symbols_until[i];
-            }
-        }
-
-        if(symsUntilNextEvent == UINT32_MAX) {
+        if(this->deadlines.isEmpty()) {
             return;
         }
 
-        uint32_t timer = this->lastDispatchSymbolCounter + symsUntilNextEvent;
+        uint32_t timer = this->deadlines.topDeadline();
 
         uint32_t currentSymCnt = _NOW;
         if(timer < currentSymCnt + 2) {
@@ -162,37 +158,22 @@ private:
     void dispatchEvents() {
         currentDispatchSymbolCounter = _NOW;
 
-        /* The difference also works if there was a wrap around since lastSymCnt (modulo by casting to uint32_t). */
-        int32_t symbolsSinceLastDispatch = (uint32_t)(currentDispatchSymbolCounter - this->lastDispatchSymbolCounter);
-
-        for(uint8_t i = 0; i < timer_t::TIMER_COUNT; ++i) {
-            if(0 < this->symbols_until[i] && this->symbols_until[i] <= symbolsSinceLastDispatch) {
-                int32_t lateness = symbolsSinceLastDispatch - this->symbols_until[i];
-                DSME_ASSERT(this->handlers[i] != nullptr);
-
-#ifdef STATISTICS_MONITOR_LATENESS
-                uint16_t bin;
-                if(static_cast<uint32_t>(lateness) > MAXIMUM_LATENESS_ALLOWED) {
-                    bin = BIN_COUNT - 1;
-                } else {
-                    bin = lateness / BIN_WIDTH;
-                }
-                lateness_histogram[i][bin]++;
-#endif
-
-                (this->instance->*(this->handlers[i]))(lateness);
-                if(wasReset) {
-                    wasReset = false;
-                    return;
-                }
+        /* Handlers may arm and stop timers, but never at or before currentDispatchSymbolCounter, so this terminates. */
+        while(!this->deadlines.isEmpty() && !isDeadlineBefore(currentDispatchSymbolCounter, this->deadlines.topDeadline())) {
+            uint16_t i = this->deadlines.top();
+            /* The difference also works if there was a wrap around since the deadline (modulo by casting to uint32_t). */
+            int32_t lateness = (uint32_t)(currentDispatchSymbolCounter - this->deadlines.topDeadline());
+            this->deadlines.cancel(i);
+            DSME_ASSERT(this->handlers[i] != nullptr);
+
+            this->latenessHistograms[i].add(lateness);
+            (this->instance->*(this->handlers[i]))(lateness);
+            if(wasReset) {
+                wasReset = false;
+                return;
             }
         }
 
-        for(uint8_t i = 0; i < timer_t::TIMER_COUNT; ++i) {
-            if(this->symbols_until[i] > 0) {
-                this->symbols_until[i] -= symbolsSinceLastDispatch;
-            }
-        }
         this->lastDispatchSymbolCounter = currentDispatchSymbolCounter;
         return;
     }
@@ -208,10 +189,9 @@ private:
     bool wasReset = false;
 
     /**
-     * Values >  0: timer is activated
-     * Values <= 0: timer has expired or is deactivated
+     * Absolute deadlines of the armed timers, a timer is removed once it has expired or is stopped
      */
-    int32_t symbols_until[timer_t::TIMER_COUNT];
+    Q deadlines;
 
     /**
      * Stores handles to methods of a subclass that get called once their associated timer expires
@@ -238,10 +218,7 @@ private:
      */
     EventHistory<T, 8> history;
 
-#ifdef STATISTICS_MONITOR_LATENESS
-public:
-    uint16_t lateness_histogram[timer_t::TIMER_COUNT][BIN_COUNT];
-#endif
+    LatenessHistogram latenessHistograms[timer_t::TIMER_COUNT];
 };
 
 } /* namespace dsme */
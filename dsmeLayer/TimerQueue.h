@@ -0,0 +1,261 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef TIMERQUEUE_H_
+#define TIMERQUEUE_H_
+
+#include "../../dsme_platform.h"
+#include "../helper/Integers.h"
+
+namespace dsme {
+
+/*
+ * Deadline queues for the TimerMultiplexer. A queue holds at most one deadline per timer ID and yields
+ * the armed timer with the earliest deadline first, equal deadlines are ordered by the lower ID.
+ * Deadlines are absolute symbol counter values and compared modulo 2^32, so a wrap around of the symbol
+ * counter is handled as long as all armed deadlines lie within 2^31 symbols of each other.
+ *
+ * TimerScanQueue keeps the deadlines in an array indexed by ID and scans it for the earliest one.
+ * TimerHeapQueue keeps them in a binary heap, which pays off once more than a handful of timers exist.
+ */
+
+/** Returns true if deadline \p a lies before \p b, also across a wrap around of the symbol counter. */
+inline bool isDeadlineBefore(uint32_t a, uint32_t b) {
+    return static_cast<int32_t>(a - b) < 0;
+}
+
+/**
+ * Arm and cancel in O(1), top() in O(N).
+ */
+template <uint16_t N>
+class TimerScanQueue {
+public:
+    TimerScanQueue() {
+        clear();
+    }
+
+    void clear() {
+        for(uint16_t i = 0; i < N; i++) {
+            this->armed[i] = false;
+        }
+        this->numArmed = 0;
+    }
+
+    bool isEmpty() const {
+        return this->numArmed == 0;
+    }
+
+    bool isArmed(uint16_t id) const {
+        return this->armed[id];
+    }
+
+    void arm(uint16_t id, uint32_t deadline) {
+        DSME_ASSERT(id < N);
+        if(!this->armed[id]) {
+            this->armed[id] = true;
+            this->numArmed++;
+        }
+        this->deadlines[id] = deadline;
+    }
+
+    void cancel(uint16_t id) {
+        DSME_ASSERT(id < N);
+        if(this->armed[id]) {
+            this->armed[id] = false;
+            this->numArmed--;
+        }
+    }
+
+    /** ID of the earliest armed timer, the queue must not be empty. */
+    uint16_t top() const {
+        DSME_ASSERT(!isEmpty());
+        uint16_t first = N;
+        for(uint16_t i = 0; i < N; i++) {
+            if(this->armed[i] && (first == N || isDeadlineBefore(this->deadlines[i], this->deadlines[first]))) {
+                first = i;
+            }
+        }
+        return first;
+    }
+
+    uint32_t topDeadline() const {
+        return this->deadlines[top()];
+    }
+
+private:
+    uint32_t deadlines[N];
+    bool armed[N];
+    uint16_t numArmed;
+};
+
+/**
+ * Arm and cancel in O(log N), top() in O(1). Every ID remembers its position in the heap, so a
+ * cancel or re-arm of an arbitrary timer does not have to search for it.
+ */
+template <uint16_t N>
+class TimerHeapQueue {
+public:
+    TimerHeapQueue() {
+        clear();
+    }
+
+    void clear() {
+        for(uint16_t i = 0; i < N; i++) {
+            this->positions[i] = NOT_ARMED;
+        }
+        this->size = 0;
+    }
+
+    bool isEmpty() const {
+        return this->size == 0;
+    }
+
+    bool isArmed(uint16_t id) const {
+        return this->positions[id] != NOT_ARMED;
+    }
+
+    void arm(uint16_t id, uint32_t deadline) {
+        DSME_ASSERT(id < N);
+        uint16_t position = this->positions[id];
+        if(position == NOT_ARMED) {
+            position = this->size++;
+            this->heap[position].id = id;
+            this->positions[id] = position;
+        } else if(isDeadlineBefore(this->heap[position].deadline, deadline)) {
+            /* '-> postponed, can only move down */
+            this->heap[position].deadline = deadline;
+            siftDown(position);
+            return;
+        }
+        this->heap[position].deadline = deadline;
+        siftUp(position);
+    }
+
+    void cancel(uint16_t id) {
+        DSME_ASSERT(id < N);
+        uint16_t position = this->positions[id];
+        if(position == NOT_ARMED) {
+            return;
+        }
+        this->positions[id] = NOT_ARMED;
+        this->size--;
+        if(position == this->size) {
+            return;
+        }
+
+        /* move the last entry into the gap, it may have to go either way */
+        this->heap[position] = this->heap[this->size];
+        this->positions[this->heap[position].id] = position;
+        if(position > 0 && isBefore(this->heap[position], this->heap[(position - 1) / 2])) {
+            siftUp(position);
+        } else {
+            siftDown(position);
+        }
+    }
+
+    /** ID of the earliest armed timer, the queue must not be empty. */
+    uint16_t top() const {
+        DSME_ASSERT(!isEmpty());
+        return this->heap[0].id;
+    }
+
+    uint32_t topDeadline() const {
+        DSME_ASSERT(!isEmpty());
+        return this->heap[0].deadline;
+    }
+
+private:
+    struct Entry {
+        uint32_t deadline;
+        uint16_t id;
+    };
+
+    static constexpr uint16_t NOT_ARMED = 0xFFFF;
+
+    static bool isBefore(const Entry& a, const Entry& b) {
+        return isDeadlineBefore(a.deadline, b.deadline) || (a.deadline == b.deadline && a.id < b.id);
+    }
+
+    void siftUp(uint16_t position) {
+        Entry entry = this->heap[position];
+        while(position > 0) {
+            uint16_t parent = (position - 1) / 2;
+            if(!isBefore(entry, this->heap[parent])) {
+                break;
+            }
+            this->heap[position] = this->heap[parent];
+            this->positions[this->heap[position].id] = position;
+            position = parent;
+        }
+        this->heap[position] = entry;
+        this->positions[entry.id] = position;
+    }
+
+    void siftDown(uint16_t position) {
+        Entry entry = this->heap[position];
+        while(true) {
+            uint16_t child = 2 * position + 1;
+            if(child >= this->size) {
+                break;
+            }
+            if(child + 1 < this->size && isBefore(this->heap[child + 1], this->heap[child])) {
+                child++;
+            }
+            if(!isBefore(this->heap[child], entry)) {
+                break;
+            }
+            this->heap[position] = this->heap[child];
+            this->positions[this->heap[position].id] = position;
+            position = child;
+        }
+        this->heap[position] = entry;
+        this->positions[entry.id] = position;
+    }
+
+    Entry heap[N];
+    uint16_t positions[N];
+    uint16_t size;
+};
+
+} /* namespace dsme */
+
+#endif /* TIMERQUEUE_H_ */
@@ -460,8 +460,9 @@ void BeaconManager::onCSMASent(IDSMEMessage* msg, CommandFrameIdentifier cmdId,
 void BeaconManager::sendDone(enum AckLayerResponse result, IDSMEMessage* msg) {
     dsme.getPlatform().releaseMessage(msg);
     transmissionPending = false;
-    DSME_ASSERT(result == AckLayerResponse::NO_ACK_REQUESTED || result == AckLayerResponse::SEND_FAILED);
-    DSME_SIM_ASSERT(result == AckLayerResponse::NO_ACK_REQUESTED);
+    /* SEND_ABORTED if superframeEvent() was too late to send the beacon */
+    DSME_ASSERT(result == AckLayerResponse::NO_ACK_REQUESTED || result == AckLayerResponse::SEND_FAILED || result == AckLayerResponse::SEND_ABORTED);
+    DSME_SIM_ASSERT(result == AckLayerResponse::NO_ACK_REQUESTED || result == AckLayerResponse::SEND_ABORTED);
 }
 
 void BeaconManager::handleBeacon(IDSMEMessage* msg) {
@@ -131,6 +131,14 @@ bool CAPLayer::pushMessage(IDSMEMessage* msg) {
     return pushed;
 }
 
+bool CAPLayer::hasQueuedMessages() {
+    bool queued;
+    DSME_ATOMIC_BLOCK {
+        queued = !this->queue.empty();
+    }
+    return queued;
+}
+
 /*****************************
  * Choices
  *****************************/
@@ -251,6 +259,12 @@ fsmReturnStatus CAPLayer::stateContention(CSMAEvent& event) {
         }
     }
     else if(event.signal == CSMAEvent::TIMER_FIRED) {
+        /* the CCA and the backoff periods of the contention window up to now are already spent */
+        uint16_t symbolsLeft = symbolsRequired() - (CW0 - CW + 1) * aUnitBackoffPeriod;
+        if(!this->dsme.isWithinCAP(now, symbolsLeft)) {
+            /* '-> the timer fired too late (overload), the frame would reach into the CFP */
+            return transition(&CAPLayer::stateBackoff);
+        }
         CW--;
         return transition(&CAPLayer::stateCCA);
     }
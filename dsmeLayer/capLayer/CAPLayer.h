@@ -71,6 +71,7 @@ public:
     explicit CAPLayer(DSMELayer& dsme);
     void reset();
     bool pushMessage(IDSMEMessage* msg);
+    bool hasQueuedMessages();
     void dispatchTimerEvent();
     void dispatchCCAResult(bool success);
     void handleStartOfCFP();
@@ -0,0 +1,144 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef GTSFSMINDEX_H_
+#define GTSFSMINDEX_H_
+
+#include "../../../dsme_platform.h"
+#include "../../helper/Integers.h"
+
+namespace dsme {
+
+/**
+ * Hash table from keys to the ids of the GTS state machines, with open addressing and linear probing.
+ * Every one of the N state machines holds at most one key, so the table is never filled to more than half.
+ * A key may be held by several state machines at once, find() then returns the lowest id like a scan over
+ * all of them would.
+ */
+template <typename K, uint8_t N>
+class GTSFsmIndex {
+    static_assert(N < 127, "the state machine ids are int8_t");
+
+public:
+    GTSFsmIndex() {
+        clear();
+    }
+
+    void clear() {
+        for(uint16_t i = 0; i < CAPACITY; i++) {
+            this->entries[i].fsmId = EMPTY;
+        }
+    }
+
+    void insert(K key, int8_t fsmId) {
+        uint16_t i = home(key);
+        while(this->entries[i].fsmId != EMPTY) {
+            DSME_ASSERT(this->entries[i].key != key || this->entries[i].fsmId != fsmId);
+            i = (i + 1) & MASK;
+        }
+        this->entries[i].key = key;
+        this->entries[i].fsmId = fsmId;
+    }
+
+    /**
+     * @return The lowest id of the state machines holding the key, -1 if there is none
+     */
+    int8_t find(K key) const {
+        int8_t result = EMPTY;
+        for(uint16_t i = home(key); this->entries[i].fsmId != EMPTY; i = (i + 1) & MASK) {
+            if(this->entries[i].key == key && (result == EMPTY || this->entries[i].fsmId < result)) {
+                result = this->entries[i].fsmId;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Removes the key of the given state machine, if it holds the key.
+     */
+    void remove(K key, int8_t fsmId) {
+        uint16_t gap = home(key);
+        while(this->entries[gap].fsmId != fsmId || this->entries[gap].key != key) {
+            if(this->entries[gap].fsmId == EMPTY) {
+                return;
+            }
+            gap = (gap + 1) & MASK;
+        }
+
+        /* close the gap with the following entries of the cluster that may be placed there, so no lookup stops early */
+        for(uint16_t i = (gap + 1) & MASK; this->entries[i].fsmId != EMPTY; i = (i + 1) & MASK) {
+            uint16_t distance = (i - home(this->entries[i].key)) & MASK;
+            if(distance >= ((i - gap) & MASK)) {
+                this->entries[gap] = this->entries[i];
+                gap = i;
+            }
+        }
+        this->entries[gap].fsmId = EMPTY;
+    }
+
+private:
+    static constexpr int8_t EMPTY = -1;
+
+    static constexpr uint16_t capacityFor(uint16_t minimum, uint16_t capacity = 1) {
+        return capacity >= minimum ? capacity : capacityFor(minimum, 2 * capacity);
+    }
+
+    static constexpr uint16_t CAPACITY = capacityFor(2 * N);
+    static constexpr uint16_t MASK = CAPACITY - 1;
+
+    static uint16_t home(K key) {
+        /* fold wide keys such as addresses, then use the upper bits of a Fibonacci hash */
+        uint32_t folded = (uint32_t)key ^ (uint32_t)(key >> 16 >> 16);
+        return (uint16_t)((folded * 2654435769u) >> 16) & MASK;
+    }
+
+    struct Entry {
+        K key;
+        int8_t fsmId;
+    };
+
+    Entry entries[CAPACITY];
+};
+
+} /* namespace dsme */
+
+#endif /* GTSFSMINDEX_H_ */
@@ -104,6 +104,7 @@ void GTSEvent::fill(IDSMEMessage* msg, GTSManagement& management, GTSReplyNotify
 }
 
 GTSManager::GTSManager(DSMELayer& dsme) : GTSManagerFSM_t(&GTSManager::stateIdle, &GTSManager::stateBusy), dsme(dsme), actUpdater(dsme) {
+    this->idleFsms.setLength(GTS_STATE_MULTIPLICITY, true);
 }
 
 void GTSManager::initialize() {
@@ -120,6 +121,8 @@ void GTSManager::reset() {
             transition(i, &GTSManager::stateIdle);
             this->data[i].msgToSend = nullptr;
         }
+        this->fsmsByPartner.clear();
+        this->fsmsByMessage.clear();
     }
 
     this->dsme.getMAC_PIB().macDSMESAB.clear();
@@ -725,6 +728,10 @@ bool GTSManager::handleGTSResponse(IDSMEMessage* msg) {
 
     if(replyNotifyCmd.getDestinationAddress() == dsme.getMAC_PIB().macShortAddress) {
         int8_t fsmId = getFsmIdFromResponseForMe(msg);
+        if(fsmId < GTS_STATE_MULTIPLICITY) {
+            /* '-> a duplicate of this response will be handled by the busy FSM */
+            fsmsByPartner.remove(getPartnerKey(data[fsmId].responsePartnerAddress, CommandFrameIdentifier::DSME_GTS_REPLY), fsmId);
+        }
         data[fsmId].responsePartnerAddress = IEEE802154MacAddress::NO_SHORT_ADDRESS;
         return dispatch(fsmId, GTSEvent::RESPONSE_CMD_FOR_ME, msg, management, replyNotifyCmd);
     } else if(management.status == GTSStatus::SUCCESS) {
@@ -761,6 +768,9 @@ bool GTSManager::handleGTSNotify(IDSMEMessage* msg) {
 
     if(replyNotifyCmd.getDestinationAddress() == dsme.getMAC_PIB().macShortAddress) {
         int8_t fsmId = getFsmIdFromNotifyForMe(msg);
+        if(fsmId < GTS_STATE_MULTIPLICITY) {
+            fsmsByPartner.remove(getPartnerKey(data[fsmId].notifyPartnerAddress, CommandFrameIdentifier::DSME_GTS_NOTIFY), fsmId);
+        }
         data[fsmId].notifyPartnerAddress = IEEE802154MacAddress::NO_SHORT_ADDRESS;
         return dispatch(fsmId, GTSEvent::NOTIFY_CMD_FOR_ME, msg, management, replyNotifyCmd);
     } else {
@@ -785,11 +795,9 @@ bool GTSManager::handleStartOfCFP(uint8_t superframe) {
 
     // also execute this during non-idle phases
     if(superframe == 0) {
-        for(DSMEAllocationCounterTable::iterator it = dsme.getMAC_PIB().macDSMEACT.begin(); it != dsme.getMAC_PIB().macDSMEACT.end(); ++it) {
-            if(it->getDirection() == Direction::RX) {
-                // New multi-superframe started, so increment the idle counter according to 5.1.10.5.3
-                it->incrementIdleCounter(); // gets reset to zero on RX
-            }
+        for(DSMEAllocationCounterTable::iterator it = dsme.getMAC_PIB().macDSMEACT.beginRX(); it != dsme.getMAC_PIB().macDSMEACT.end(); ++it) {
+            // New multi-superframe started, so increment the idle counter according to 5.1.10.5.3
+            it->incrementIdleCounter(); // gets reset to zero on RX
         }
     }
 
@@ -818,20 +826,15 @@ bool GTSManager::onCSMASent(IDSMEMessage* msg, CommandFrameIdentifier cmdId, Dat
         LOG_INFO("DUPLICATED_ALLOCATION_NOTIFICATION sent");
         returnStatus = true;
     } else {
-        int8_t validFsmId = -1;
+        // Check which statemachine waits for this msg
+        int8_t validFsmId = fsmsByMessage.find(reinterpret_cast<uintptr_t>(msg));
 
-        for(uint8_t i = 0; i < GTS_STATE_MULTIPLICITY; ++i) {
-            // Check which statemachine waits for this msg
-            if(data[i].msgToSend == msg) {
-                data[i].msgToSend = nullptr;
-                DSME_ASSERT(getState(i) == &GTSManager::stateSending ||
-                            getState(i) == &GTSManager::stateIdle); // The FSM might still execute the sendGTSCommand in the IDLE state
-                validFsmId = i;
-                break;
-            }
-        }
+        if(validFsmId >= 0) {
+            fsmsByMessage.remove(reinterpret_cast<uintptr_t>(msg), validFsmId);
+            data[validFsmId].msgToSend = nullptr;
+            DSME_ASSERT(getState(validFsmId) == &GTSManager::stateSending ||
+                        getState(validFsmId) == &GTSManager::stateIdle); // The FSM might still execute the sendGTSCommand in the IDLE state
 
-        if(validFsmId >= 0 && validFsmId < GTS_STATE_MULTIPLICITY) {
             if(status != DataStatus::SUCCESS) {
                 LOG_DEBUG("GTSManager::onCSMASent transmission failure: " << (int16_t)status);
             }
@@ -937,12 +940,25 @@ bool GTSManager::sendGTSCommand(uint8_t fsmId, IDSMEMessage* msg, GTSManagement&
     // is handled inside of the onCSMASent.
     if(reportOnSent && (man.type != ManagementType::DUPLICATED_ALLOCATION_NOTIFICATION)) {
         DSME_ASSERT(fsmId < GTS_STATE_MULTIPLICITY);
+        if(data[fsmId].msgToSend != nullptr) {
+            /* '-> the previous message was not reported back, it is outdated now */
+            fsmsByMessage.remove(reinterpret_cast<uintptr_t>(data[fsmId].msgToSend), fsmId);
+        }
         data[fsmId].cmdToSend = commandId;
         data[fsmId].msgToSend = msg;
+        fsmsByMessage.insert(reinterpret_cast<uintptr_t>(msg), fsmId);
     }
 
     numGTSMessages++;
-    return dsme.getMessageDispatcher().sendInCAP(msg);
+    if(!dsme.getMessageDispatcher().sendInCAP(msg)) {
+        /* '-> the caller releases the message, so it must not be matched when the pool hands it out again */
+        if(data[fsmId].msgToSend == msg) {
+            fsmsByMessage.remove(reinterpret_cast<uintptr_t>(msg), fsmId);
+            data[fsmId].msgToSend = nullptr;
+        }
+        return false;
+    }
+    return true;
 }
 
 void GTSManager::preparePendingConfirm(GTSEvent& event) {
@@ -967,13 +983,37 @@ void GTSManager::preparePendingConfirm(GTSEvent& event) {
  * FSM identification helpers
  *****************************/
 
+fsmReturnStatus GTSManager::transition(int8_t fsmId, GTSManagerFSM_t::state_t next) {
+    GTSManagerFSM_t::state_t current = getState(fsmId);
+    if(current == &GTSManager::stateIdle) {
+        idleFsms.set(fsmId, false);
+    } else if(current == &GTSManager::stateWaitForResponse) {
+        fsmsByPartner.remove(getPartnerKey(data[fsmId].responsePartnerAddress, CommandFrameIdentifier::DSME_GTS_REPLY), fsmId);
+    } else if(current == &GTSManager::stateWaitForNotify) {
+        fsmsByPartner.remove(getPartnerKey(data[fsmId].notifyPartnerAddress, CommandFrameIdentifier::DSME_GTS_NOTIFY), fsmId);
+    }
+
+    if(next == &GTSManager::stateIdle) {
+        idleFsms.set(fsmId, true);
+    } else if(next == &GTSManager::stateWaitForResponse) {
+        fsmsByPartner.insert(getPartnerKey(data[fsmId].responsePartnerAddress, CommandFrameIdentifier::DSME_GTS_REPLY), fsmId);
+    } else if(next == &GTSManager::stateWaitForNotify) {
+        fsmsByPartner.insert(getPartnerKey(data[fsmId].notifyPartnerAddress, CommandFrameIdentifier::DSME_GTS_NOTIFY), fsmId);
+    }
+
+    return GTSManagerFSM_t::transition(fsmId, next);
+}
+
+uint32_t GTSManager::getPartnerKey(uint16_t address, CommandFrameIdentifier awaitedCmd) {
+    return ((uint32_t)awaitedCmd << 16) | address;
+}
+
 int8_t GTSManager::getFsmIdIdle() {
-    for(uint8_t i = 0; i < GTS_STATE_MULTIPLICITY; ++i) {
-        if(getState(i) == &GTSManager::stateIdle) {
-            return i;
-        }
+    BitVector<GTS_STATE_MULTIPLICITY>::iterator it = idleFsms.beginSetBits();
+    if(it == idleFsms.endSetBits()) {
+        return -1;
     }
-    return -1;
+    return *it;
 }
 
 int8_t GTSManager::getFsmIdForRequest() {
@@ -996,32 +1036,18 @@ int8_t GTSManager::getFsmIdForResponse(uint16_t destinationAddress) {
 
 int8_t GTSManager::getFsmIdFromResponseForMe(IDSMEMessage* msg) {
     uint16_t srcAddress = msg->getHeader().getSrcAddr().getShortAddress();
-    for(uint8_t i = 0; i < GTS_STATE_MULTIPLICITY; ++i) {
-        if(getState(i) == &GTSManager::stateWaitForResponse && data[i].responsePartnerAddress == srcAddress) {
-            return i;
-        }
-    }
-    return GTS_STATE_MULTIPLICITY;
+    int8_t fsmId = fsmsByPartner.find(getPartnerKey(srcAddress, CommandFrameIdentifier::DSME_GTS_REPLY));
+    return fsmId >= 0 ? fsmId : GTS_STATE_MULTIPLICITY;
 }
 
 int8_t GTSManager::getFsmIdFromNotifyForMe(IDSMEMessage* msg) {
     uint16_t srcAddress = msg->getHeader().getSrcAddr().getShortAddress();
-    for(uint8_t i = 0; i < GTS_STATE_MULTIPLICITY; ++i) {
-        if(getState(i) == &GTSManager::stateWaitForNotify && data[i].notifyPartnerAddress == srcAddress) {
-            return i;
-        }
-    }
-    return GTS_STATE_MULTIPLICITY;
+    int8_t fsmId = fsmsByPartner.find(getPartnerKey(srcAddress, CommandFrameIdentifier::DSME_GTS_NOTIFY));
+    return fsmId >= 0 ? fsmId : GTS_STATE_MULTIPLICITY;
 }
 
 bool GTSManager::hasBusyFsm() {
-    bool busyFsm = false;
-    for(uint8_t i = 0; i < GTS_STATE_MULTIPLICITY; ++i) {
-        if(getState(i) != &GTSManager::stateIdle) {
-            busyFsm = true;
-        }
-    }
-    return busyFsm;
+    return idleFsms.count(true) < GTS_STATE_MULTIPLICITY;
 }
 
 } /* namespace dsme */
@@ -44,10 +44,12 @@
 #define GTSMANAGER_H_
 
 #include "../../../DSMEMessage.h"
+#include "../../../dsme_settings.h"
 #include "../../helper/DSMEBufferedMultiFSM.h"
 #include "../../helper/DSMEFSM.h"
 #include "../../helper/Integers.h"
 #include "../../mac_services/DSME_Common.h"
+#include "../../mac_services/dataStructures/DSMEBitVector.h"
 #include "../../mac_services/mlme_sap/DSME_GTS.h"
 #include "../messages/GTSManagement.h"
 #include "../messages/GTSReplyNotifyCmd.h"
@@ -56,12 +58,20 @@
 #include "../neighbors/NeighborQueue.h"
 #include "./ACTUpdater.h"
 #include "./GTSData.h"
+#include "./GTSFsmIndex.h"
 
 namespace dsme {
 class IDSMEMessage;
 } /* namespace dsme */
 
-constexpr uint8_t GTS_STATE_MULTIPLICITY = 4;
+/* The number of GTS handshakes that may be in progress at the same time, e.g. a coordinator answering many joining children. */
+#if !defined(DSME_GTS_STATE_MULTIPLICITY)
+#define DSME_GTS_STATE_MULTIPLICITY 4
+#endif
+constexpr uint8_t GTS_STATE_MULTIPLICITY = DSME_GTS_STATE_MULTIPLICITY;
+
+/* handleStartOfCFP posts CFP_STARTED to every waiting FSM and to an idle one, if it interrupts a dispatch all of these are buffered. */
+constexpr uint8_t GTS_EVENT_BUFFER_SIZE = dsme::ringBufferCapacity(GTS_STATE_MULTIPLICITY + 1);
 
 namespace dsme {
 
@@ -99,7 +109,7 @@ private:
 
 class GTSManager;
 
-typedef DSMEBufferedMultiFSM<GTSManager, GTSEvent, GTS_STATE_MULTIPLICITY, GTS_STATE_MULTIPLICITY> GTSManagerFSM_t;
+typedef DSMEBufferedMultiFSM<GTSManager, GTSEvent, GTS_STATE_MULTIPLICITY, GTS_EVENT_BUFFER_SIZE> GTSManagerFSM_t;
 
 class GTSManager : private GTSManagerFSM_t {
 public:
@@ -219,9 +229,15 @@ private:
     static const char* signalToString(uint8_t signal);
     static const char* stateToString(GTSManagerFSM_t::state_t state);
 
+    /**
+     * Hides GTSManagerFSM_t::transition to keep the FSM identification helpers up to date.
+     */
+    fsmReturnStatus transition(int8_t fsmId, GTSManagerFSM_t::state_t next);
+
     /**
      * FSM identification helpers
      */
+    static uint32_t getPartnerKey(uint16_t address, CommandFrameIdentifier awaitedCmd);
     int8_t getFsmIdIdle();
     int8_t getFsmIdForRequest();
     int8_t getFsmIdForResponse(uint16_t destinationAddress);
@@ -236,6 +252,10 @@ private:
     DSMELayer& dsme;
     ACTUpdater actUpdater;
     GTSData data[GTS_STATE_MULTIPLICITY + 1];
+
+    BitVector<GTS_STATE_MULTIPLICITY> idleFsms;
+    GTSFsmIndex<uint32_t, GTS_STATE_MULTIPLICITY> fsmsByPartner; // FSMs waiting for a reply or notify, by getPartnerKey()
+    GTSFsmIndex<uintptr_t, GTS_STATE_MULTIPLICITY> fsmsByMessage; // FSMs waiting for a sent message, by msgToSend
 };
 
 } /* namespace dsme */
@@ -71,10 +71,11 @@ namespace dsme {
 
 MessageDispatcher::MessageDispatcher(DSMELayer& dsme)
     : dsme(dsme),
-      currentACTElement(nullptr, nullptr),
+      currentACTElement(nullptr, 0),
       doneGTS(DELEGATE(&MessageDispatcher::sendDoneGTS, *this)),
       dsmeAckFrame(nullptr),
       lastSendGTSNeighbor(neighborQueue.end()) {
+    neighborQueue.setWatermarks(DSME_GTS_QUEUE_LOW_WATERMARK, DSME_GTS_QUEUE_HIGH_WATERMARK, DELEGATE(&MessageDispatcher::handleQueueWatermark, *this));
 }
 
 MessageDispatcher::~MessageDispatcher() {
@@ -88,6 +89,8 @@ MessageDispatcher::~MessageDispatcher() {
 
 void MessageDispatcher::initialize(void) {
     currentACTElement = dsme.getMAC_PIB().macDSMEACT.end();
+    dsme.getMAC_PIB().macDSMEACT.setChangeDelegate(DELEGATE(&MessageDispatcher::rebuildSlotPlan, *this));
+    rebuildSlotPlan();
     return;
 }
 
@@ -111,6 +114,7 @@ void MessageDispatcher::reset(void) {
         NeighborQueue<MAX_NEIGHBORS>::iterator it = this->neighborQueue.begin();
         this->neighborQueue.eraseNeighbor(it);
     }
+    rebuildSlotPlan();
 
     return;
 }
@@ -118,6 +122,7 @@ void MessageDispatcher::reset(void) {
 
 void MessageDispatcher::sendDoneGTS(enum AckLayerResponse response, IDSMEMessage* msg) {
     LOG_DEBUG("sendDoneGTS");
+    this->gtsFrameInFlight = false;
 
     DSME_ASSERT(lastSendGTSNeighbor != neighborQueue.end());
     DSME_ASSERT(msg == neighborQueue.front(lastSendGTSNeighbor));
@@ -147,11 +152,7 @@ void MessageDispatcher::sendDoneGTS(enum AckLayerResponse response, IDSMEMessage
     this->preparedMsg = nullptr;
 
     /* STATISTICS */
-    uint16_t totalSize = 0;
-    for(NeighborQueue<MAX_NEIGHBORS>::iterator it = neighborQueue.begin(); it != neighborQueue.end(); ++it) {
-        totalSize += it->queueSize;
-    }
-    this->dsme.getPlatform().signalQueueLength(totalSize);
+    this->dsme.getPlatform().signalQueueLength(neighborQueue.getPacketsInQueues());
     /* END STATISTICS */
 
     mcps_sap::DATA_confirm_parameters params;
@@ -262,32 +263,37 @@ void MessageDispatcher::onCSMASent(IDSMEMessage* msg, DataStatus::Data_Status st
     }
 }
 
-bool MessageDispatcher::sendInGTS(IDSMEMessage* msg, NeighborQueue<MAX_NEIGHBORS>::iterator destIt) {
+bool MessageDispatcher::sendInGTS(IDSMEMessage* msg, NeighborQueue<MAX_NEIGHBORS>::iterator destIt, uint8_t priorityClass) {
     DSME_ASSERT(!msg->getHeader().getDestAddr().isBroadcast());
     DSME_ASSERT(this->dsme.getMAC_PIB().macAssociatedPANCoord);
     DSME_ASSERT(destIt != neighborQueue.end());
 
     numUpperPacketsForGTS++;
 
-    if(!neighborQueue.isQueueFull()) {
-        /* push into queue */
-        // TODO implement TRANSACTION_EXPIRED
-        uint16_t totalSize = 0;
-        for(NeighborQueue<MAX_NEIGHBORS>::iterator it = neighborQueue.begin(); it != neighborQueue.end(); ++it) {
-            totalSize += it->queueSize;
-        }
-        LOG_INFO("NeighborQueue is at " << totalSize << "/" << TOTAL_GTS_QUEUE_SIZE << ".");
-        neighborQueue.pushBack(destIt, msg);
-        this->dsme.getPlatform().signalQueueLength(totalSize+1);
+    if(priorityClass >= GTS_QUEUE_PRIORITY_CLASSES) {
+        LOG_DEBUG("Priority class " << (uint16_t)priorityClass << " exceeds DSME_GTS_QUEUE_PRIORITY_CLASSES.");
+        priorityClass = GTS_QUEUE_PRIORITY_CLASSES - 1;
+    }
+
+    /* push into queue */
+    // TODO implement TRANSACTION_EXPIRED
+    LOG_INFO("NeighborQueue is at " << (uint16_t)neighborQueue.getPacketsInQueues() << "/" << TOTAL_GTS_QUEUE_SIZE << ".");
+    if(neighborQueue.pushBack(destIt, msg, priorityClass)) {
+        this->dsme.getPlatform().signalQueueLength(neighborQueue.getPacketsInQueues());
         return true;
     } else {
-        /* queue full */
-        LOG_INFO("NeighborQueue is full!");
+        /* queue full or quota of the neighbor exhausted */
+        LOG_INFO("NeighborQueue is full for " << destIt->address.getShortAddress() << "!");
         numUpperPacketsDroppedFullQueue++;
         return false;
     }
 }
 
+void MessageDispatcher::handleQueueWatermark(bool aboveHighWatermark) {
+    LOG_INFO("NeighborQueue is " << (aboveHighWatermark ? "above the high" : "at the low") << " watermark.");
+    this->dsme.getPlatform().signalQueueWatermark(aboveHighWatermark);
+}
+
 bool MessageDispatcher::sendInCAP(IDSMEMessage* msg) {
     LOG_INFO("Inserting message into CAP queue.");
     if(msg->getHeader().getSrcAddrMode() != EXTENDED_ADDRESS && !(this->dsme.getMAC_PIB().macAssociatedPANCoord)) {
@@ -393,10 +399,9 @@ bool MessageDispatcher::handlePreSlotEvent(uint8_t nextSlot, uint8_t nextSuperfr
         if(this->currentACTElement->getDirection() == Direction::RX) {
             this->currentACTElement = act.end();
         } else {
-            // Rarely happens, only if the sendDoneGTS is delayed
+            // Rarely happens, only if the sendDoneGTS is delayed, e.g. by a late timer interrupt
             // Then skip this preSlotEvent
             LOG_DEBUG("Previous slot did not finish until preslot event: slot " << (int)nextSlot << " SF " << (int)nextSuperframe);
-            DSME_SIM_ASSERT(false);
             return false;
         }
     }
@@ -405,11 +410,14 @@ bool MessageDispatcher::handlePreSlotEvent(uint8_t nextSlot, uint8_t nextSuperfr
         /* '-> next slot will be GTS */
 
         unsigned nextGTS = nextSlot - (this->dsme.getMAC_PIB().helper.getFinalCAPSlot(nextSuperframe) + 1);
-        if(act.isAllocated(nextSuperframe, nextGTS)) {
+        DSME_ASSERT(nextGTS < MAX_GTSLOTS);
+        DSME_SIM_ASSERT(this->slotPlanRevision == act.getRevision());
+
+        this->currentACTElement = act.find(nextSuperframe, nextGTS);
+        if(this->currentACTElement != act.end()) {
             /* '-> this slot might be used */
 
-            this->currentACTElement = act.find(nextSuperframe, nextGTS);
-            DSME_ASSERT(this->currentACTElement != act.end());
+            this->currentSlotPlanEntry = &this->slotPlan[nextSuperframe * MAX_GTSLOTS + nextGTS];
             // For TX currentACTElement will be reset in finalizeGTSTransmission, called by
             // either handleGTS if nothing is to send or by sendDoneGTS.
             // For RX it is reset in the next handlePreSlotEvent.   TODO: is the reset actually required?
@@ -419,7 +427,7 @@ bool MessageDispatcher::handlePreSlotEvent(uint8_t nextSlot, uint8_t nextSuperfr
                 this->dsme.getPlatform().turnTransceiverOn();
 
                 if(dsme.getMAC_PIB().macChannelDiversityMode == Channel_Diversity_Mode::CHANNEL_ADAPTATION) {
-                    this->dsme.getPlatform().setChannelNumber(this->dsme.getMAC_PIB().helper.getChannels()[this->currentACTElement->getChannel()]);
+                    this->dsme.getPlatform().setChannelNumber(this->currentSlotPlanEntry->channel);
                 } else {
                     uint8_t channel = nextHoppingSequenceChannel(nextSlot, nextSuperframe, nextMultiSuperframe);
                     this->dsme.getPlatform().setChannelNumber(channel);
@@ -432,7 +440,6 @@ bool MessageDispatcher::handlePreSlotEvent(uint8_t nextSlot, uint8_t nextSuperfr
             }
         } else {
             /* '-> nothing to do during this slot */
-            DSME_ASSERT(this->currentACTElement == act.end());
             transceiverOffIfAssociated();
         }
     } else if(nextSlot == 0) {
@@ -455,6 +462,32 @@ bool MessageDispatcher::handlePreSlotEvent(uint8_t nextSlot, uint8_t nextSuperfr
     return true;
 }
 
+void MessageDispatcher::rebuildSlotPlan() {
+    DSMEAllocationCounterTable& act = this->dsme.getMAC_PIB().macDSMEACT;
+    const channelList_t& channels = this->dsme.getMAC_PIB().helper.getChannels();
+
+    for(DSMEAllocationCounterTable::iterator it = act.begin(); it != act.end(); ++it) {
+        SlotPlanEntry& entry = this->slotPlan[it->getSuperframeID() * MAX_GTSLOTS + it->getGTSlotID()];
+        entry.channel = (it->getChannel() < channels.getLength()) ? channels[it->getChannel()] : 0;
+        entry.neighbor = NO_PLAN_NEIGHBOR;
+    }
+
+    /* only neighbors known by their short address can own a slot */
+    uint8_t index = 0;
+    for(NeighborQueue<MAX_NEIGHBORS>::iterator neighbor = this->neighborQueue.begin(); neighbor != this->neighborQueue.end(); ++neighbor, ++index) {
+        this->slotPlanNeighbors[index] = neighbor;
+        if(!neighbor->address.isShortAddress()) {
+            continue;
+        }
+        uint16_t address = neighbor->address.getShortAddress();
+        for(DSMEAllocationCounterTable::iterator it = act.beginNeighbor(address, Direction::TX); it != act.end(); ++it) {
+            this->slotPlan[it->getSuperframeID() * MAX_GTSLOTS + it->getGTSlotID()].neighbor = index;
+        }
+    }
+
+    this->slotPlanRevision = act.getRevision();
+}
+
 uint8_t MessageDispatcher::nextHoppingSequenceChannel(uint8_t nextSlot, uint8_t nextSuperframe, uint8_t nextMultiSuperframe) {
     uint16_t hoppingSequenceLength = this->dsme.getMAC_PIB().macHoppingSequenceLength;
     uint8_t ebsn = 0; // this->dsme.getMAC_PIB().macPanCoordinatorBsn;    //TODO is this set correctly
@@ -479,14 +512,25 @@ bool MessageDispatcher::handleSlotEvent(uint8_t slot, uint8_t superframe, int32_
     return true;
 }
 
+void MessageDispatcher::handleMissedSlot(uint8_t slot, uint8_t superframe) {
+    if(slot > dsme.getMAC_PIB().helper.getFinalCAPSlot(superframe) && this->currentACTElement != this->dsme.getMAC_PIB().macDSMEACT.end() &&
+       this->currentACTElement->getDirection() == TX && !this->gtsFrameInFlight) {
+        /* '-> the queued messages stay queued for the next GTS of the link, an RX slot stays listening,
+         *     a frame in flight is finalized by the IFS event after its sendDoneGTS */
+        finalizeGTSTransmission();
+    }
+}
+
 bool MessageDispatcher::handleIFSEvent(int32_t lateness) {
     /* Neighbor and slot have to be valid at this point */
     DSME_ASSERT(this->lastSendGTSNeighbor != this->neighborQueue.end());
     DSME_ASSERT(this->currentACTElement != this->dsme.getMAC_PIB().macDSMEACT.end());
-    DSME_ASSERT(this->currentACTElement->getSuperframeID() == this->dsme.getCurrentSuperframe() && this->currentACTElement->getGTSlotID()
-      == this->dsme.getCurrentSlot() - (this->dsme.getMAC_PIB().helper.getFinalCAPSlot(this->dsme.getCurrentSuperframe())+1));
 
-    if(!sendPreparedMessage()) {
+    if(this->currentACTElement->getSuperframeID() != this->dsme.getCurrentSuperframe() || this->currentACTElement->getGTSlotID()
+      != this->dsme.getCurrentSlot() - (this->dsme.getMAC_PIB().helper.getFinalCAPSlot(this->dsme.getCurrentSuperframe())+1)) {
+        /* '-> the IFS timer fired late, after the end of the slot */
+        finalizeGTSTransmission();
+    } else if(!sendPreparedMessage()) {
         finalizeGTSTransmission();
     }
 
@@ -509,8 +553,7 @@ void MessageDispatcher::handleGTS(int32_t lateness) {
             DSME_ASSERT(this->lastSendGTSNeighbor == this->neighborQueue.end());
 
             IEEE802154MacAddress adr = IEEE802154MacAddress(this->currentACTElement->getAddress());
-            this->lastSendGTSNeighbor = this->neighborQueue.findByAddress(IEEE802154MacAddress(this->currentACTElement->getAddress()));
-            if(this->lastSendGTSNeighbor == this->neighborQueue.end()) {
+            if(this->currentSlotPlanEntry->neighbor == NO_PLAN_NEIGHBOR) {
                 /* '-> the neighbor associated with the current slot does not exist */
 
                 LOG_ERROR("neighborQueue.size: " << ((uint8_t) this->neighborQueue.getNumNeighbors()));
@@ -521,6 +564,7 @@ void MessageDispatcher::handleGTS(int32_t lateness) {
                 }
                 DSME_ASSERT(false);
             }
+            this->lastSendGTSNeighbor = this->slotPlanNeighbors[this->currentSlotPlanEntry->neighbor];
 
             bool success = prepareNextMessageIfAny();
             LOG_DEBUG(success);
@@ -605,6 +649,7 @@ bool MessageDispatcher::sendPreparedMessage() {
         /* '-> Sufficient time to send message in remaining slot time */
         if (this->dsme.getAckLayer().prepareSendingCopy(this->preparedMsg, this->doneGTS)) {
             /* '-> Message transmission can be attempted */
+            this->gtsFrameInFlight = true;
             this->dsme.getAckLayer().sendNowIfPending();
             this->numTxGtsFrames++;
         } else {
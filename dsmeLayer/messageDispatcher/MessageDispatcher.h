@@ -49,6 +49,15 @@
 #include "../ackLayer/AckLayer.h"
 #include "../neighbors/NeighborQueue.h"
 
+/* watermarks of the messages queued for all neighbors, see IDSMEPlatform::signalQueueWatermark */
+#if !defined(DSME_GTS_QUEUE_HIGH_WATERMARK)
+#define DSME_GTS_QUEUE_HIGH_WATERMARK (TOTAL_GTS_QUEUE_SIZE * 3 / 4)
+#endif
+
+#if !defined(DSME_GTS_QUEUE_LOW_WATERMARK)
+#define DSME_GTS_QUEUE_LOW_WATERMARK (TOTAL_GTS_QUEUE_SIZE / 4)
+#endif
+
 namespace dsme {
 
 class DSMELayer;
@@ -70,9 +79,10 @@ public:
      *
      * \param msg The message to transmit
      * \param destIt The destination device
+     * \param priorityClass The priority class in the queue of the destination, 0 is the least urgent
      * \return false if the GTS queue is full, true otherwise
      */
-    bool sendInGTS(IDSMEMessage* msg, NeighborQueue<MAX_NEIGHBORS>::iterator destIt);
+    bool sendInGTS(IDSMEMessage* msg, NeighborQueue<MAX_NEIGHBORS>::iterator destIt, uint8_t priorityClass);
 
     /*! Queues a message for transmission during the CAP.
      *
@@ -89,6 +99,12 @@ public:
     inline void addNeighbor(const IEEE802154MacAddress& address) {
         Neighbor n(address);
         neighborQueue.addNeighbor(n);
+        rebuildSlotPlan();
+    }
+
+    inline void eraseNeighbor(NeighborQueue<MAX_NEIGHBORS>::iterator& neighbor) {
+        neighborQueue.eraseNeighbor(neighbor);
+        rebuildSlotPlan();
     }
 
     inline bool neighborExists(const IEEE802154MacAddress& address) {
@@ -99,6 +115,14 @@ public:
         this->multiplePacketsPerGTS = multiplePacketsPerGTS;
     }
 
+    /*! Selects how the next message for a neighbor is taken from its priority classes.
+     *
+     * \param weighted false to always serve the most urgent class, true to serve class c with a share proportional to 2^c
+     */
+    inline void setWeightedPriorityDequeue(bool weighted) {
+        neighborQueue.setWeightedDequeue(weighted);
+    }
+
 
 /* Event handlers (START) ----------------------------------------------------*/
     /*! This shall be called shortly before the start of every slot to allow for setting up the transceiver.
@@ -120,6 +144,12 @@ public:
      */
     bool handleSlotEvent(uint8_t slot, uint8_t superframe, int32_t lateness);
 
+    /*!
+     * This shall be called instead of handleSlotEvent when the slot event came too late to serve the slot.
+     * A transmission prepared for the slot is dropped, so no frame is sent across the slot boundary.
+     */
+    void handleMissedSlot(uint8_t slot, uint8_t superframe);
+
     /*!
      * This shall be called one SIFS or LIFS after the reception of an acknowledgement,
      * depending on the length of the transmitted frame. Transmits the next frame
@@ -150,6 +180,12 @@ public:
      */
     void receive(IDSMEMessage* msg);
 
+    /*! This shall be called when the messages queued for all neighbors cross a watermark.
+     *
+     * \param aboveHighWatermark true if the high watermark was reached, false if the low watermark was reached again
+     */
+    void handleQueueWatermark(bool aboveHighWatermark);
+
 /* Event handlers (END) ------------------------------------------------------*/
 
 protected:
@@ -163,8 +199,33 @@ protected:
 
     NeighborQueue<MAX_NEIGHBORS>::iterator lastSendGTSNeighbor;
 
+    /*! Resolved data of an allocated GTS, only valid while the slot is allocated in the ACT. */
+    struct SlotPlanEntry {
+        uint8_t channel;  ///< channel number used for channel adaptation
+        uint8_t neighbor; ///< index into slotPlanNeighbors for TX slots, NO_PLAN_NEIGHBOR if there is no such neighbor
+    };
+
+    static constexpr uint8_t NO_PLAN_NEIGHBOR = 0xFF;
+
+    /*! Plan of the multi-superframe indexed by superframe * MAX_GTSLOTS + GTS, compiled from the ACT
+     *  by rebuildSlotPlan() right where the ACT or the neighbors change, so preparing a slot does not search
+     *  the neighbors. The ACT element is still looked up for its direction and state, which change without
+     *  a new revision, and the channel for channel hopping is still computed per slot.
+     */
+    SlotPlanEntry slotPlan[MAX_SUPERFRAMES_PER_MULTI_SUPERFRAME * MAX_GTSLOTS];
+    NeighborQueue<MAX_NEIGHBORS>::iterator slotPlanNeighbors[MAX_NEIGHBORS];
+    uint16_t slotPlanRevision{0};
+
+    /*! The plan entry of the slot currentACTElement refers to. */
+    const SlotPlanEntry* currentSlotPlanEntry{nullptr};
+
+    void rebuildSlotPlan();
+
     IDSMEMessage *preparedMsg{nullptr};
 
+    /*! A GTS frame was handed to the AckLayer and its sendDoneGTS is still due. */
+    bool gtsFrameInFlight{false};
+
     /*!
      * Called on start of every GTSlot.
      * Switch channel for reception or transmit from queue in allocated slots. TODO: correct?
@@ -215,6 +276,12 @@ public:
         return numUpperPacketsDroppedFullQueue;
     }
 
+    /*! The part of getNumUpperPacketsDroppedFullQueue() for the given neighbor, counted while it is known. */
+    long getNumUpperPacketsDroppedFullQueue(const IEEE802154MacAddress& address) {
+        NeighborQueue<MAX_NEIGHBORS>::iterator neighbor = neighborQueue.findByAddress(address);
+        return (neighbor != neighborQueue.end()) ? neighborQueue.getNumDroppedPackets(neighbor) : 0;
+    }
+
     long getNumUpperPacketsForCAP() const {
         return numUpperPacketsForCAP;
     }
@@ -59,11 +59,20 @@ typedef uint8_t queue_size_t;
 
 /**
  * A queue for a fixed maximum number of messages for different neighbors
+ *
+ * The messages of a neighbor are sorted into C priority classes that share the chunk, higher classes are more urgent.
+ * The front message of a neighbor comes from the most urgent non-empty class, or with weighted dequeue each class
+ * gets a share of the messages proportional to 2^class. Once handed out by front(), a message stays at the front until
+ * it is removed, so a message under transmission is never overtaken.
+ *
  * @template-param T type of nodes to store
  * @template-param S size of allocated chunk
+ * @template-param C number of priority classes
  */
-template <typename T, uint8_t S>
+template <typename T, uint8_t S, uint8_t C = 1>
 class MultiMessageQueue {
+    static_assert(C > 0 && C <= 8, "the weights of the priority classes are int16_t");
+
 private:
     /**
      * Represents one memory chunk to store a fixed number of messages
@@ -93,66 +102,92 @@ public:
      * -> time: O(1)
      * @param neighbor the neighbor the message belongs to
      * @param msg pointer to the message, ownership STAYS with caller
+     * @param priorityClass class of the message, 0 is the least urgent, larger values are clamped to C - 1
      */
-    void push_back(NeighborListEntry<T>& neighbor, T* msg);
+    void push_back(NeighborListEntry<T, C>& neighbor, T* msg, uint8_t priorityClass = 0);
 
     /**
-     * Gets and removes the first (oldest) element of the queue of a neighbor, nullptr if not existent
-     * -> time: O(1)
+     * Gets and removes the front element of the queue of a neighbor, nullptr if not existent
+     * -> time: O(C)
      * @param neighbor the neighbor the message belongs to
      */
-    T* pop_front(NeighborListEntry<T>& neighbor);
+    T* pop_front(NeighborListEntry<T, C>& neighbor);
 
     /**
-     * Gets the first (oldest) element of the queue of a neighbor, nullptr if not existent
+     * Gets the front element of the queue of a neighbor, nullptr if not existent
      * -> time: O(1)
      * @param neighbor the neighbor the message belongs to
      */
-    T* front(const NeighborListEntry<T>& neighbor);
+    T* front(const NeighborListEntry<T, C>& neighbor);
 
     /**
-     * Deletes all [but first] messages from the queue of a neighbor
-     * -> time: O(neighbor->queueSize)
+     * Deletes all [but front] messages from the queue of a neighbor
+     * -> time: O(neighbor->queueSize + C)
      * @param neighbor the neighbor the messages belong to
-     * @param if true, first message is preserved
+     * @param if true, front message is preserved
      */
-    void flush(NeighborListEntry<T>& neighbor, bool keepFront);
+    void flush(NeighborListEntry<T, C>& neighbor, bool keepFront);
 
     bool isFull() const {
         return full;
     }
 
+    /**
+     * Gets the number of messages of all neighbors
+     * -> time: O(1)
+     */
+    queue_size_t getSize() const {
+        return size;
+    }
+
+    /**
+     * Selects between strict priority (default) and weighted dequeue of the priority classes
+     */
+    void setWeightedDequeue(bool weighted) {
+        this->weightedDequeue = weighted;
+    }
+
 private:
     Chunk chunk;
 
+    /* number of messages of all neighbors */
+    queue_size_t size;
+
     /* flag, set if queue is full */
     bool full;
 
+    bool weightedDequeue;
+
     MessageQueueEntry<T>* freeFront;
     MessageQueueEntry<T>* freeBack;
 
     inline void addToFree(MessageQueueEntry<T>* entry);
+
+    void selectFrontClass(NeighborListEntry<T, C>& neighbor);
 };
 
 /* FUNCTION DEFINITIONS ******************************************************/
 
-template <typename T, uint8_t S>
-MultiMessageQueue<T, S>::MultiMessageQueue() : full(false) {
+template <typename T, uint8_t S, uint8_t C>
+MultiMessageQueue<T, S, C>::MultiMessageQueue() : size(0), full(false), weightedDequeue(false) {
     this->freeFront = &(this->chunk.data[0]);
     this->freeBack = &(this->chunk.data[S - 1]);
 }
 
-template <typename T, uint8_t S>
-MultiMessageQueue<T, S>::~MultiMessageQueue() {
+template <typename T, uint8_t S, uint8_t C>
+MultiMessageQueue<T, S, C>::~MultiMessageQueue() {
 }
 
-template <typename T, uint8_t S>
-void MultiMessageQueue<T, S>::push_back(NeighborListEntry<T>& neighbor, T* msg) {
+template <typename T, uint8_t S, uint8_t C>
+void MultiMessageQueue<T, S, C>::push_back(NeighborListEntry<T, C>& neighbor, T* msg, uint8_t priorityClass) {
     if(this->full) {
         /* '-> all slots are used */
         DSME_ASSERT(false);
         return;
     }
+    if(priorityClass >= C) {
+        priorityClass = C - 1;
+    }
 
     MessageQueueEntry<T>* entry = this->freeFront;
 
@@ -169,36 +204,46 @@ void MultiMessageQueue<T, S>::push_back(NeighborListEntry<T>& neighbor, T* msg)
     entry->value = msg;
     entry->next = nullptr;
 
-    if(neighbor.messageBack != nullptr) {
-        neighbor.messageBack->next = entry;
+    if(neighbor.messageBack[priorityClass] != nullptr) {
+        neighbor.messageBack[priorityClass]->next = entry;
+    }
+    neighbor.messageBack[priorityClass] = entry;
+
+    if(neighbor.messageFront[priorityClass] == nullptr) {
+        neighbor.messageFront[priorityClass] = neighbor.messageBack[priorityClass];
     }
-    neighbor.messageBack = entry;
 
-    if(neighbor.messageFront == nullptr) {
-        neighbor.messageFront = neighbor.messageBack;
+    if(neighbor.queueSize == 0) {
+        /* '-> the only message is the front message */
+        neighbor.frontClass = priorityClass;
     }
 
     neighbor.queueSize++;
+    this->size++;
 }
 
-template <typename T, uint8_t S>
-T* MultiMessageQueue<T, S>::pop_front(NeighborListEntry<T>& neighbor) {
+template <typename T, uint8_t S, uint8_t C>
+T* MultiMessageQueue<T, S, C>::pop_front(NeighborListEntry<T, C>& neighbor) {
     if(neighbor.queueSize > 0) {
         /* '-> queue contains messages for this neighbor */
 
-        MessageQueueEntry<T>* entry = neighbor.messageFront;
+        uint8_t priorityClass = neighbor.frontClass;
+        MessageQueueEntry<T>* entry = neighbor.messageFront[priorityClass];
         T* msg = entry->value;
 
-        neighbor.messageFront = entry->next;
+        neighbor.messageFront[priorityClass] = entry->next;
 
-        if(neighbor.messageFront == nullptr) {
-            neighbor.messageBack = nullptr;
+        if(neighbor.messageFront[priorityClass] == nullptr) {
+            neighbor.messageBack[priorityClass] = nullptr;
         }
 
         this->addToFree(entry);
 
         neighbor.queueSize--;
+        this->size--;
         this->full = false;
+
+        selectFrontClass(neighbor);
         return msg;
     } else {
         /* '-> no messages pending for this neighbor */
@@ -206,55 +251,61 @@ T* MultiMessageQueue<T, S>::pop_front(NeighborListEntry<T>& neighbor) {
     }
 }
 
-template <typename T, uint8_t S>
-T* MultiMessageQueue<T, S>::front(const NeighborListEntry<T>& neighbor) {
-    return (neighbor.messageFront != nullptr) ? neighbor.messageFront->value : nullptr;
+template <typename T, uint8_t S, uint8_t C>
+T* MultiMessageQueue<T, S, C>::front(const NeighborListEntry<T, C>& neighbor) {
+    MessageQueueEntry<T>* entry = neighbor.messageFront[neighbor.frontClass];
+    return (entry != nullptr) ? entry->value : nullptr;
 }
 
-template <typename T, uint8_t S>
-void MultiMessageQueue<T, S>::flush(NeighborListEntry<T>& neighbor, bool keepFront) {
-    MessageQueueEntry<T>* entry = neighbor.messageFront;
-
-    if(keepFront && entry != nullptr) {
-        /* keep existing first entry */
-        MessageQueueEntry<T>* temp = entry;
-        entry = entry->next;
-        temp->next = nullptr;
+template <typename T, uint8_t S, uint8_t C>
+void MultiMessageQueue<T, S, C>::flush(NeighborListEntry<T, C>& neighbor, bool keepFront) {
+    this->size -= neighbor.queueSize;
+    neighbor.queueSize = 0;
 
-        neighbor.queueSize = 1;
-    } else {
-        /* discard first entry or list already empty */
-        neighbor.messageFront = nullptr;
-        neighbor.queueSize = 0;
-    }
+    for(uint8_t priorityClass = 0; priorityClass < C; priorityClass++) {
+        MessageQueueEntry<T>* entry = neighbor.messageFront[priorityClass];
 
-    if(entry != nullptr) {
-        /* '-> there are entries to be invalidated */
-        this->full = false;
-    } else {
-        /* '-> nothing to do */
-        return;
-    }
+        if(keepFront && priorityClass == neighbor.frontClass && entry != nullptr) {
+            /* keep existing front entry */
+            MessageQueueEntry<T>* temp = entry;
+            entry = entry->next;
+            temp->next = nullptr;
 
-    /*
-     * taken out of the loop for efficiency
-     */
-    this->addToFree(entry);
-    entry = entry->next;
+            neighbor.queueSize = 1;
+        } else {
+            /* discard front entry or list already empty */
+            neighbor.messageFront[priorityClass] = nullptr;
+        }
+        neighbor.messageBack[priorityClass] = neighbor.messageFront[priorityClass];
+
+        if(entry != nullptr) {
+            /* '-> there are entries to be invalidated */
+            this->full = false;
+        } else {
+            /* '-> nothing to do */
+            continue;
+        }
 
-    while(entry != nullptr) {
-        entry->value = nullptr;
-        this->freeBack->next = entry;
-        this->freeBack = entry;
+        /*
+         * taken out of the loop for efficiency
+         */
+        this->addToFree(entry);
         entry = entry->next;
+
+        while(entry != nullptr) {
+            entry->value = nullptr;
+            this->freeBack->next = entry;
+            this->freeBack = entry;
+            entry = entry->next;
+        }
     }
 
-    neighbor.messageBack = neighbor.messageFront;
+    this->size += neighbor.queueSize;
     return;
 }
 
-template <typename T, uint8_t S>
-inline void MultiMessageQueue<T, S>::addToFree(MessageQueueEntry<T>* entry) {
+template <typename T, uint8_t S, uint8_t C>
+inline void MultiMessageQueue<T, S, C>::addToFree(MessageQueueEntry<T>* entry) {
     DSME_ASSERT(entry != nullptr);
     entry->value = nullptr;
 
@@ -269,6 +320,42 @@ inline void MultiMessageQueue<T, S>::addToFree(MessageQueueEntry<T>* entry) {
     return;
 }
 
+template <typename T, uint8_t S, uint8_t C>
+void MultiMessageQueue<T, S, C>::selectFrontClass(NeighborListEntry<T, C>& neighbor) {
+    if(neighbor.queueSize == 0) {
+        /* '-> chosen by the next push_back */
+        return;
+    }
+
+    if(!this->weightedDequeue) {
+        for(uint8_t priorityClass = C; priorityClass-- > 0;) {
+            if(neighbor.messageFront[priorityClass] != nullptr) {
+                neighbor.frontClass = priorityClass;
+                return;
+            }
+        }
+        DSME_ASSERT(false);
+    }
+
+    /* smooth weighted round robin: every non-empty class earns its weight, the richest one pays the sum of them */
+    int16_t totalWeight = 0;
+    uint8_t selected = C;
+    for(uint8_t priorityClass = 0; priorityClass < C; priorityClass++) {
+        if(neighbor.messageFront[priorityClass] == nullptr) {
+            continue;
+        }
+        int16_t weight = 1 << priorityClass;
+        neighbor.credits[priorityClass] += weight;
+        totalWeight += weight;
+        if(selected == C || neighbor.credits[priorityClass] >= neighbor.credits[selected]) {
+            selected = priorityClass;
+        }
+    }
+    DSME_ASSERT(selected < C);
+    neighbor.credits[selected] -= totalWeight;
+    neighbor.frontClass = selected;
+}
+
 } /* namespace dsme */
 
 #endif /* MULTIMESSAGEQUEUE_H_ */
@@ -56,22 +56,61 @@ typedef uint8_t queue_size_t;
 
 /* STRUCTS *******************************************************************/
 
-template <typename T>
+/*
+ * @template-param C number of priority classes, each with its own FIFO of messages
+ */
+template <typename T, uint8_t C = 1>
 struct NeighborListEntry : public Neighbor {
 public:
+    /* an unused entry of a neighbor pool */
+    NeighborListEntry();
     explicit NeighborListEntry(Neighbor& neighbor);
     virtual ~NeighborListEntry() = default;
 
-    MessageQueueEntry<T>* messageFront;
-    MessageQueueEntry<T>* messageBack;
+    MessageQueueEntry<T>* messageFront[C];
+    MessageQueueEntry<T>* messageBack[C];
 
+    /* number of messages of all classes */
     queue_size_t queueSize;
+
+    /* class of the message at the front, it is only chosen anew once that message is removed */
+    uint8_t frontClass;
+
+    /* state of the weighted dequeue, see MultiMessageQueue::setWeightedDequeue */
+    int16_t credits[C];
+
+    /* quota of the neighbor in the shared queue, see NeighborQueue::setQuota */
+    queue_size_t minQueued;
+    queue_size_t maxQueued;
+
+    /* messages for this neighbor rejected because of its quota or a full queue */
+    uint32_t numDropped;
+
+private:
+    void clearClasses();
 };
 
 /* FUNCTION DEFINITIONS ******************************************************/
 
-template <typename T>
-NeighborListEntry<T>::NeighborListEntry(Neighbor& neighbor) : Neighbor(neighbor), messageFront(nullptr), messageBack(nullptr), queueSize(0) {
+template <typename T, uint8_t C>
+NeighborListEntry<T, C>::NeighborListEntry()
+    : Neighbor(IEEE802154MacAddress()), queueSize(0), frontClass(0), minQueued(0), maxQueued(UINT8_MAX), numDropped(0) {
+    clearClasses();
+}
+
+template <typename T, uint8_t C>
+NeighborListEntry<T, C>::NeighborListEntry(Neighbor& neighbor)
+    : Neighbor(neighbor), queueSize(0), frontClass(0), minQueued(0), maxQueued(UINT8_MAX), numDropped(0) {
+    clearClasses();
+}
+
+template <typename T, uint8_t C>
+void NeighborListEntry<T, C>::clearClasses() {
+    for(uint8_t i = 0; i < C; i++) {
+        this->messageFront[i] = nullptr;
+        this->messageBack[i] = nullptr;
+        this->credits[i] = 0;
+    }
 }
 
 } /* namespace dsme */
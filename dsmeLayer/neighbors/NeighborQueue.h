@@ -45,13 +45,27 @@
 
 /* INCLUDES ******************************************************************/
 
+#include "../../../dsme_platform.h"
 #include "../../../dsme_settings.h"
+#include "../../helper/DSMEDelegate.h"
 #include "../../helper/Integers.h"
-#include "../../mac_services/dataStructures/RBTree.h"
-#include "../../mac_services/dataStructures/RBTreeIterator.h"
 #include "./MultiMessageQueue.h"
 #include "./Neighbor.h"
 
+/* number of priority classes of the messages queued for each neighbor, see MultiMessageQueue */
+#if !defined(DSME_GTS_QUEUE_PRIORITY_CLASSES)
+#define DSME_GTS_QUEUE_PRIORITY_CLASSES 1
+#endif
+
+/* default quota of every neighbor in the shared queue, see NeighborQueue::setQuota */
+#if !defined(DSME_GTS_QUEUE_MIN_PER_NEIGHBOR)
+#define DSME_GTS_QUEUE_MIN_PER_NEIGHBOR 0
+#endif
+
+#if !defined(DSME_GTS_QUEUE_MAX_PER_NEIGHBOR)
+#define DSME_GTS_QUEUE_MAX_PER_NEIGHBOR TOTAL_GTS_QUEUE_SIZE
+#endif
+
 namespace dsme {
 
 /* TYPES *********************************************************************/
@@ -59,28 +73,86 @@ namespace dsme {
 typedef uint8_t neighbor_size_t;
 class IDSMEMessage;
 
+constexpr uint8_t GTS_QUEUE_PRIORITY_CLASSES = DSME_GTS_QUEUE_PRIORITY_CLASSES;
+
 /* CLASSES *******************************************************************/
 
 /*
+ * Neighbors live in a fixed pool of entries and keep their entry until they are erased, so iterators are stable
+ * handles that may be cached. The packed addresses are indexed by an open-addressing hash table with linear probing,
+ * iteration runs over a dense list of the entries in use.
+ *
  * @template-param N maximum number of neighbors
  */
 template <uint8_t N>
 class NeighborQueue {
+    static_assert(N < 255, "the entries are indexed by uint8_t");
+
 public:
-    typedef RBTree<NeighborListEntry<IDSMEMessage>, IEEE802154MacAddress>::iterator iterator;
+    typedef NeighborListEntry<IDSMEMessage, GTS_QUEUE_PRIORITY_CLASSES> entry_t;
+
+    class iterator {
+        friend class NeighborQueue<N>;
+
+    public:
+        /* an iterator that does not belong to any queue, it has to be assigned before use */
+        iterator() : queue(nullptr), entry(N) {
+        }
+
+        iterator& operator++() {
+            neighbor_size_t next = this->queue->positions[this->entry] + 1;
+            this->entry = (next < this->queue->numNeighbors) ? this->queue->order[next] : N;
+            return *this;
+        }
+
+        entry_t& operator*() {
+            return this->queue->entries[this->entry];
+        }
+
+        entry_t* operator->() {
+            return &this->queue->entries[this->entry];
+        }
+
+        const entry_t* operator->() const {
+            return &this->queue->entries[this->entry];
+        }
+
+        bool operator==(const iterator& other) const {
+            return this->entry == other.entry;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return this->entry != other.entry;
+        }
+
+    private:
+        iterator(NeighborQueue<N>* queue, neighbor_size_t entry) : queue(queue), entry(entry) {
+        }
+
+        NeighborQueue<N>* queue;
+        neighbor_size_t entry;
+    };
+
+    /*
+     * called with true once the messages of all neighbors reach the high watermark,
+     * and with false once they drop to the low watermark again
+     */
+    typedef Delegate<void(bool aboveHighWatermark)> watermarkDelegate_t;
+
+    NeighborQueue();
 
     iterator begin();
 
     const iterator end() const;
 
     /*
-     * adds a Neighbor
+     * adds a Neighbor, unless it is already known or there is no space left
      * @param neighbor which will be added
      */
     void addNeighbor(Neighbor& neighbor);
 
     /*
-     * erase a Neighbor
+     * erase a Neighbor, this invalidates all iterators to it
      * @param address for the element which should be erased
      */
     void eraseNeighbor(iterator& neighbor);
@@ -101,7 +173,11 @@ public:
 
     IDSMEMessage* popFront(iterator& neighbor);
 
-    void pushBack(iterator& neighbor, IDSMEMessage* msg);
+    /*
+     * @param priorityClass class of the message, 0 is the least urgent, larger values than supported are clamped
+     * @return false if the message was rejected because of the quota of the neighbor or a full queue
+     */
+    bool pushBack(iterator& neighbor, IDSMEMessage* msg, uint8_t priorityClass);
 
     void flushQueues(bool keepFront);
 
@@ -109,50 +185,190 @@ public:
         return queue.isFull();
     }
 
+    /*
+     * gives the number of messages of all neighbors
+     * -> time: O(1)
+     */
+    queue_size_t getPacketsInQueues() const {
+        return queue.getSize();
+    }
+
+    /*
+     * @param low the delegate is called with false once the number of messages drops to this value
+     * @param high the delegate is called with true once the number of messages reaches this value
+     */
+    void setWatermarks(queue_size_t low, queue_size_t high, watermarkDelegate_t delegate);
+
+    /*
+     * Sets the quota of a neighbor in the shared queue. Up to minQueued messages are always accepted, as the free
+     * entries not yet used by neighbors below their minimum are held back. Beyond that a neighbor may use the remaining
+     * entries, but never hold more than maxQueued messages. If the minimums add up to more than TOTAL_GTS_QUEUE_SIZE,
+     * no entries remain beyond them and the neighbors below their minimum get the free entries in the order their
+     * messages arrive, until the queue is full. New neighbors get DSME_GTS_QUEUE_MIN_PER_NEIGHBOR and
+     * DSME_GTS_QUEUE_MAX_PER_NEIGHBOR.
+     */
+    void setQuota(iterator& neighbor, queue_size_t minQueued, queue_size_t maxQueued);
+
+    /*
+     * gives the number of messages for a neighbor rejected by pushBack
+     */
+    uint32_t getNumDroppedPackets(const iterator& neighbor) const {
+        return neighbor->numDropped;
+    }
+
+    /*
+     * selects between strict priority (default) and weighted dequeue of the priority classes
+     */
+    void setWeightedDequeue(bool weighted) {
+        queue.setWeightedDequeue(weighted);
+    }
+
 private:
-    MultiMessageQueue<IDSMEMessage, TOTAL_GTS_QUEUE_SIZE> queue;
-    RBTree<NeighborListEntry<IDSMEMessage>, IEEE802154MacAddress> neighbors;
+    static constexpr neighbor_size_t EMPTY = N;
+
+    static constexpr uint16_t capacityFor(uint16_t minimum, uint16_t capacity = 1) {
+        return capacity >= minimum ? capacity : capacityFor(minimum, 2 * capacity);
+    }
+
+    /* at most half of the buckets are in use, so the probe sequences stay short */
+    static constexpr uint16_t CAPACITY = capacityFor(2 * N);
+    static constexpr uint16_t MASK = CAPACITY - 1;
+
+    static uint16_t home(uint64_t key) {
+        /* fold the address, then use the upper bits of a Fibonacci hash */
+        uint32_t folded = (uint32_t)key ^ (uint32_t)(key >> 32);
+        return (uint16_t)((folded * 2654435769u) >> 16) & MASK;
+    }
+
+    struct Bucket {
+        uint64_t key;
+        neighbor_size_t entry;
+    };
+
+    MultiMessageQueue<IDSMEMessage, TOTAL_GTS_QUEUE_SIZE, GTS_QUEUE_PRIORITY_CLASSES> queue;
+
+    entry_t entries[N];
+    Bucket buckets[CAPACITY];
+
+    /* order[0..numNeighbors) are the entries in use, the remaining ones are free */
+    neighbor_size_t order[N];
+    neighbor_size_t positions[N];
+    neighbor_size_t numNeighbors;
+
+    /* free entries held back for the neighbors below their minimum, their sum may exceed the queue */
+    uint16_t reservedEntries;
+
+    static queue_size_t getMissingEntries(const entry_t& entry) {
+        return (entry.queueSize < entry.minQueued) ? entry.minQueued - entry.queueSize : 0;
+    }
+
+    queue_size_t lowWatermark;
+    queue_size_t highWatermark;
+    bool aboveHighWatermark;
+    watermarkDelegate_t watermarkDelegate;
+
+    void checkWatermarks();
 };
 
 /* FUNCTION DEFINITIONS ******************************************************/
 
+template <uint8_t N>
+NeighborQueue<N>::NeighborQueue() : numNeighbors(0), reservedEntries(0), lowWatermark(0), highWatermark(TOTAL_GTS_QUEUE_SIZE), aboveHighWatermark(false) {
+    for(neighbor_size_t i = 0; i < N; i++) {
+        this->order[i] = i;
+        this->positions[i] = i;
+    }
+    for(uint16_t i = 0; i < CAPACITY; i++) {
+        this->buckets[i].entry = EMPTY;
+    }
+}
+
 template <uint8_t N>
 typename NeighborQueue<N>::iterator NeighborQueue<N>::begin() {
-    return neighbors.begin();
+    return iterator(this, (this->numNeighbors > 0) ? this->order[0] : N);
 }
 
 template <uint8_t N>
 const typename NeighborQueue<N>::iterator NeighborQueue<N>::end() const {
-    return neighbors.end();
+    return iterator();
 }
 
 template <uint8_t N>
 void NeighborQueue<N>::addNeighbor(Neighbor& neighbor) {
-    if(neighbors.size() < N) {
-        neighbors.insert(NeighborListEntry<IDSMEMessage>(neighbor), neighbor.address);
-        return;
-    } else {
+    if(this->numNeighbors == N) {
         return;
     }
+
+    uint64_t key = neighbor.address.getPacked();
+    uint16_t i = home(key);
+    while(this->buckets[i].entry != EMPTY) {
+        if(this->buckets[i].key == key) {
+            /* '-> neighbor is already known */
+            return;
+        }
+        i = (i + 1) & MASK;
+    }
+
+    neighbor_size_t entry = this->order[this->numNeighbors++];
+    this->entries[entry] = entry_t(neighbor);
+    this->entries[entry].minQueued = DSME_GTS_QUEUE_MIN_PER_NEIGHBOR;
+    this->entries[entry].maxQueued = DSME_GTS_QUEUE_MAX_PER_NEIGHBOR;
+    this->reservedEntries += getMissingEntries(this->entries[entry]);
+    this->buckets[i].key = key;
+    this->buckets[i].entry = entry;
+    return;
 }
 
 template <uint8_t N>
 void NeighborQueue<N>::eraseNeighbor(iterator& neighbor) {
-    if(neighbor != neighbors.end()) {
-        queue.flush(*neighbor, false);
-        neighbors.remove(neighbor);
+    if(neighbor == end()) {
+        return;
     }
+    this->reservedEntries -= getMissingEntries(*neighbor);
+    queue.flush(*neighbor, false);
+    checkWatermarks();
+
+    uint64_t key = neighbor->address.getPacked();
+    uint16_t gap = home(key);
+    while(this->buckets[gap].entry != neighbor.entry) {
+        DSME_ASSERT(this->buckets[gap].entry != EMPTY);
+        gap = (gap + 1) & MASK;
+    }
+
+    /* close the gap with the following buckets of the cluster that may be placed there, so no lookup stops early */
+    for(uint16_t i = (gap + 1) & MASK; this->buckets[i].entry != EMPTY; i = (i + 1) & MASK) {
+        uint16_t distance = (i - home(this->buckets[i].key)) & MASK;
+        if(distance >= ((i - gap) & MASK)) {
+            this->buckets[gap] = this->buckets[i];
+            gap = i;
+        }
+    }
+    this->buckets[gap].entry = EMPTY;
+
+    /* swap the entry with the last one in use, this keeps the list dense */
+    neighbor_size_t position = this->positions[neighbor.entry];
+    neighbor_size_t last = this->order[--this->numNeighbors];
+    this->order[position] = last;
+    this->positions[last] = position;
+    this->order[this->numNeighbors] = neighbor.entry;
+    this->positions[neighbor.entry] = this->numNeighbors;
     return;
 }
 
 template <uint8_t N>
 neighbor_size_t NeighborQueue<N>::getNumNeighbors() const {
-    return neighbors.size();
+    return this->numNeighbors;
 }
 
 template <uint8_t N>
 typename NeighborQueue<N>::iterator NeighborQueue<N>::findByAddress(const IEEE802154MacAddress& address) {
-    return neighbors.find(address);
+    uint64_t key = address.getPacked();
+    for(uint16_t i = home(key); this->buckets[i].entry != EMPTY; i = (i + 1) & MASK) {
+        if(this->buckets[i].key == key) {
+            return iterator(this, this->buckets[i].entry);
+        }
+    }
+    return end();
 }
 
 template <uint8_t N>
@@ -176,23 +392,84 @@ IDSMEMessage* NeighborQueue<N>::front(iterator& neighbor) {
 
 template <uint8_t N>
 IDSMEMessage* NeighborQueue<N>::popFront(iterator& neighbor) {
-    return queue.pop_front(*neighbor);
+    this->reservedEntries -= getMissingEntries(*neighbor);
+    IDSMEMessage* msg = queue.pop_front(*neighbor);
+    this->reservedEntries += getMissingEntries(*neighbor);
+    checkWatermarks();
+    return msg;
 }
 
 template <uint8_t N>
-void NeighborQueue<N>::pushBack(iterator& neighbor, IDSMEMessage* msg) {
-    queue.push_back(*neighbor, msg);
-    return;
+bool NeighborQueue<N>::pushBack(iterator& neighbor, IDSMEMessage* msg, uint8_t priorityClass) {
+    bool accepted;
+    if(queue.isFull() || neighbor->queueSize >= neighbor->maxQueued) {
+        accepted = false;
+    } else if(neighbor->queueSize < neighbor->minQueued) {
+        /* '-> uses an entry held back for this neighbor */
+        accepted = true;
+    } else {
+        /* '-> only the entries not held back for other neighbors may be used */
+        accepted = (TOTAL_GTS_QUEUE_SIZE - queue.getSize() > this->reservedEntries);
+    }
+
+    if(!accepted) {
+        neighbor->numDropped++;
+        return false;
+    }
+
+    this->reservedEntries -= getMissingEntries(*neighbor);
+    queue.push_back(*neighbor, msg, priorityClass);
+    this->reservedEntries += getMissingEntries(*neighbor);
+    checkWatermarks();
+    return true;
 }
 
 template <uint8_t N>
 void NeighborQueue<N>::flushQueues(bool keepFront) {
-    for(iterator i = neighbors.begin(); i != neighbors.end(); ++i) {
+    for(iterator i = begin(); i != end(); ++i) {
+        this->reservedEntries -= getMissingEntries(*i);
         queue.flush(*i, keepFront);
+        this->reservedEntries += getMissingEntries(*i);
     }
+    checkWatermarks();
     return;
 }
 
+template <uint8_t N>
+void NeighborQueue<N>::setQuota(iterator& neighbor, queue_size_t minQueued, queue_size_t maxQueued) {
+    DSME_ASSERT(minQueued <= maxQueued);
+    this->reservedEntries -= getMissingEntries(*neighbor);
+    neighbor->minQueued = minQueued;
+    neighbor->maxQueued = maxQueued;
+    this->reservedEntries += getMissingEntries(*neighbor);
+}
+
+template <uint8_t N>
+void NeighborQueue<N>::setWatermarks(queue_size_t low, queue_size_t high, watermarkDelegate_t delegate) {
+    DSME_ASSERT(low < high);
+    this->lowWatermark = low;
+    this->highWatermark = high;
+    this->watermarkDelegate = delegate;
+    checkWatermarks();
+}
+
+template <uint8_t N>
+void NeighborQueue<N>::checkWatermarks() {
+    /* the hysteresis between both watermarks keeps a queue at the limit from signalling every message */
+    queue_size_t size = queue.getSize();
+    if(!this->aboveHighWatermark && size >= this->highWatermark) {
+        this->aboveHighWatermark = true;
+    } else if(this->aboveHighWatermark && size <= this->lowWatermark) {
+        this->aboveHighWatermark = false;
+    } else {
+        return;
+    }
+
+    if(this->watermarkDelegate) {
+        this->watermarkDelegate(this->aboveHighWatermark);
+    }
+}
+
 } /* namespace dsme */
 
 #endif /* NEIGHBORQUEUE_H_ */
@@ -0,0 +1,118 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef BITOPERATIONS_H_
+#define BITOPERATIONS_H_
+
+#include "./Integers.h"
+
+namespace dsme {
+
+/*
+ * Word-wide bit operations, mapped to the compiler builtins (and therefore to single
+ * instructions on most targets) where available.
+ */
+
+inline uint8_t popcount(uint32_t x) {
+#if defined(__GNUC__)
+    return __builtin_popcountl(x);
+#else
+    uint8_t count = 0;
+    while(x > 0) {
+        count++;
+        x &= x - 1; // Wegner (1960)
+    }
+    return count;
+#endif
+}
+
+inline uint8_t popcount(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(x);
+#else
+    return popcount((uint32_t)x) + popcount((uint32_t)(x >> 32));
+#endif
+}
+
+/* x must not be 0 */
+inline uint8_t countTrailingZeros(uint32_t x) {
+#if defined(__GNUC__)
+    return __builtin_ctzl(x);
+#else
+    uint8_t count = 0;
+    while((x & 1) == 0) {
+        count++;
+        x >>= 1;
+    }
+    return count;
+#endif
+}
+
+/* x must not be 0 */
+inline uint8_t countTrailingZeros(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    if((uint32_t)x != 0) {
+        return countTrailingZeros((uint32_t)x);
+    }
+    return 32 + countTrailingZeros((uint32_t)(x >> 32));
+#endif
+}
+
+/* x must not be 0 */
+inline uint8_t countLeadingZeros(uint32_t x) {
+#if defined(__GNUC__)
+    return __builtin_clzl(x) - (8 * sizeof(unsigned long) - 32);
+#else
+    uint8_t count = 0;
+    while((x & 0x80000000) == 0) {
+        count++;
+        x <<= 1;
+    }
+    return count;
+#endif
+}
+
+} /* namespace dsme */
+
+#endif /* BITOPERATIONS_H_ */
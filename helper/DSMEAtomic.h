@@ -75,6 +75,85 @@ private:
 
 #define DSME_ATOMIC_BLOCK for(atomic_helper::AtomicActionWrapper __instance{}; __instance; __instance.deactivate())
 
+/* Accesses for lock-free data structures, they fall back to DSME_ATOMIC_BLOCK if the compiler has no atomic builtins. */
+namespace atomic_helper {
+
+template <typename T>
+inline T loadRelaxed(const T* value) {
+#if defined(__GNUC__)
+    return __atomic_load_n(value, __ATOMIC_RELAXED);
+#else
+    return *(const volatile T*)value;
+#endif
+}
+
+template <typename T>
+inline T loadAcquire(const T* value) {
+#if defined(__GNUC__)
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#else
+    T result;
+    DSME_ATOMIC_BLOCK {
+        result = *(const volatile T*)value;
+    }
+    return result;
+#endif
+}
+
+template <typename T>
+inline void storeRelease(T* value, T desired) {
+#if defined(__GNUC__)
+    __atomic_store_n(value, desired, __ATOMIC_RELEASE);
+#else
+    DSME_ATOMIC_BLOCK {
+        *(volatile T*)value = desired;
+    }
+#endif
+}
+
+/* returns the previous value */
+template <typename T>
+inline T exchange(T* value, T desired) {
+#if defined(__GNUC__)
+    return __atomic_exchange_n(value, desired, __ATOMIC_SEQ_CST);
+#else
+    T result;
+    DSME_ATOMIC_BLOCK {
+        result = *(volatile T*)value;
+        *(volatile T*)value = desired;
+    }
+    return result;
+#endif
+}
+
+/* returns true and stores desired if value equals expected */
+template <typename T>
+inline bool compareExchange(T* value, T expected, T desired) {
+#if defined(__GNUC__)
+    return __atomic_compare_exchange_n(value, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+#else
+    bool result;
+    DSME_ATOMIC_BLOCK {
+        result = (*(volatile T*)value == expected);
+        if(result) {
+            *(volatile T*)value = desired;
+        }
+    }
+    return result;
+#endif
+}
+
+inline void fence() {
+#if defined(__GNUC__)
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#else
+    DSME_ATOMIC_BLOCK {
+    }
+#endif
+}
+
+} /* namespace atomic_helper */
+
 } /* namespace dsme */
 
 #endif /* DSMEATOMIC_H_ */
@@ -43,6 +43,7 @@
 #ifndef DSMEBUFFEREDFSM_H_
 #define DSMEBUFFEREDFSM_H_
 
+#include "./DSMEAtomic.h"
 #include "./DSMEFSM.h"
 #include "./DSMERingbuffer.h"
 #include "./Integers.h"
@@ -65,34 +66,22 @@ public:
 
     template <typename... Args>
     bool dispatch(uint16_t signal, Args&... args) {
-        bool canAdd;
-        bool isBusy;
-        bool returnValue;
-
-        DSME_ATOMIC_BLOCK {
-            canAdd = !this->eventBuffer.isFull();
-            DSME_ASSERT(canAdd); // TODO: Remove after testing? Should never trigger when S is chosen correctly.
-
-            if(canAdd) {
-                this->eventBuffer.freeElement()->fill(signal, args...);
-                this->eventBuffer.pushFreeElement();
-            }
-
-            isBusy = this->dispatchBusy;
-            if(isBusy) {
-                returnValue = canAdd;
-            } else {
-                DSME_ASSERT(canAdd);
-                returnValue = true;
-                this->dispatchBusy = true;
-            }
+        ringbuffer_size_t position;
+        E* event = this->eventBuffer.claim(position);
+        DSME_ASSERT(event != nullptr); // TODO: Remove after testing? Should never trigger when S is chosen correctly.
+        if(event == nullptr) {
+            return false;
         }
+        event->fill(signal, args...);
+        this->eventBuffer.publish(position);
 
-        if(!isBusy) {
+        /* '-> whoever takes dispatchBusy runs the queue, also the events posted while it does so */
+        atomic_helper::fence();
+        if(!atomic_helper::exchange(&this->dispatchBusy, true)) {
             runUntilFinished();
         }
 
-        return returnValue;
+        return true;
     }
 
     inline fsmReturnStatus transition(state_t next) {
@@ -108,13 +97,23 @@ public:
 
 protected:
     bool isDispatchBusy() {
-        return this->dispatchBusy;
+        return atomic_helper::loadRelaxed(&this->dispatchBusy);
     }
 
 private:
     void runUntilFinished() {
-        while(!eventBuffer.isEmpty()) {
+        while(true) {
             E* currentEvent = this->eventBuffer.front();
+            if(currentEvent == nullptr) {
+                /* '-> hand dispatchBusy back and look again, an event published meanwhile is either found here or
+                 *     its producer takes dispatchBusy. A claimed but unpublished event is run by its producer. */
+                atomic_helper::exchange(&this->dispatchBusy, false);
+                atomic_helper::fence();
+                currentEvent = this->eventBuffer.front();
+                if(currentEvent == nullptr || atomic_helper::exchange(&this->dispatchBusy, true)) {
+                    break;
+                }
+            }
 
             state_t s = state;
             fsmReturnStatus r = (((C*)this)->*state)(*currentEvent);
@@ -133,13 +132,14 @@ private:
             }
             this->eventBuffer.pop();
         }
-        dispatchBusy = false;
         return;
     }
 
     state_t state;
     bool dispatchBusy;
-    DSMERingBuffer<E, S> eventBuffer;
+    /* Producers in task and interrupt context claim their element with a compare-and-swap and hand dispatchBusy over with an
+     * exchange, so neither posting nor dispatching masks interrupts. Only the context holding dispatchBusy consumes. */
+    DSMEMPSCRingBuffer<E, S> eventBuffer;
 };
 
 } /* namespace dsme */
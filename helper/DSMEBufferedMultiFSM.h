@@ -43,6 +43,7 @@
 #ifndef DSMEBUFFEREDMULTIFSM_H_
 #define DSMEBUFFEREDMULTIFSM_H_
 
+#include "./DSMEAtomic.h"
 #include "./DSMEFSM.h"
 #include "./DSMERingbuffer.h"
 #include "./Integers.h"
@@ -90,35 +91,23 @@ public:
     bool dispatch(int8_t fsmId, uint16_t signal, Args&... args) {
         DSME_ASSERT(fsmId >= 0 && fsmId <= N);
 
-        bool canAdd;
-        bool isBusy;
-        bool returnValue;
-
-        DSME_ATOMIC_BLOCK {
-            canAdd = !this->eventBuffer.isFull();
-            DSME_ASSERT(canAdd); // TODO: Remove after testing? Should never trigger when S is chosen correctly.
-
-            if(canAdd) {
-                this->eventBuffer.freeElement()->setFsmId(fsmId);
-                this->eventBuffer.freeElement()->fill(signal, args...);
-                this->eventBuffer.pushFreeElement();
-            }
-
-            isBusy = this->dispatchBusy;
-            if(isBusy) {
-                returnValue = canAdd;
-            } else {
-                DSME_ASSERT(canAdd);
-                returnValue = true;
-                this->dispatchBusy = true;
-            }
+        ringbuffer_size_t position;
+        E* event = this->eventBuffer.claim(position);
+        DSME_ASSERT(event != nullptr); // TODO: Remove after testing? Should never trigger when S is chosen correctly.
+        if(event == nullptr) {
+            return false;
         }
+        event->setFsmId(fsmId);
+        event->fill(signal, args...);
+        this->eventBuffer.publish(position);
 
-        if(!isBusy) {
+        /* '-> whoever takes dispatchBusy runs the queue, also the events posted while it does so */
+        atomic_helper::fence();
+        if(!atomic_helper::exchange(&this->dispatchBusy, true)) {
             runUntilFinished();
         }
 
-        return returnValue;
+        return true;
     }
 
     inline fsmReturnStatus transition(int8_t fsmId, state_t next) {
@@ -138,8 +127,18 @@ public:
 
 private:
     void runUntilFinished() {
-        while(!eventBuffer.isEmpty()) {
+        while(true) {
             E* currentEvent = this->eventBuffer.front();
+            if(currentEvent == nullptr) {
+                /* '-> hand dispatchBusy back and look again, an event published meanwhile is either found here or
+                 *     its producer takes dispatchBusy. A claimed but unpublished event is run by its producer. */
+                atomic_helper::exchange(&this->dispatchBusy, false);
+                atomic_helper::fence();
+                currentEvent = this->eventBuffer.front();
+                if(currentEvent == nullptr || atomic_helper::exchange(&this->dispatchBusy, true)) {
+                    break;
+                }
+            }
 
             int8_t fsmId = currentEvent->getFsmId();
             state_t state = states[fsmId];
@@ -162,13 +161,13 @@ private:
             }
             this->eventBuffer.pop();
         }
-        dispatchBusy = false;
         return;
     }
 
     state_t states[N + 1];
     bool dispatchBusy;
-    DSMERingBuffer<E, S> eventBuffer;
+    /* posting and consuming are lock-free, see DSMEBufferedFSM */
+    DSMEMPSCRingBuffer<E, S> eventBuffer;
 };
 
 } /* namespace dsme */
@@ -50,6 +50,11 @@ namespace dsme {
 
 typedef uint8_t ringbuffer_size_t;
 
+/* the smallest power of two of at least n, as the lock-free ring buffers require it as capacity */
+constexpr ringbuffer_size_t ringBufferCapacity(uint16_t n, ringbuffer_size_t capacity = 1) {
+    return capacity >= n ? capacity : ringBufferCapacity(n, (ringbuffer_size_t)(capacity * 2));
+}
+
 template <typename T, ringbuffer_size_t N>
 class DSMERingBuffer {
 private:
@@ -115,6 +120,76 @@ public:
     }
 };
 
+/**
+ * Bounded multi-producer/single-consumer ring buffer that does not need DSME_ATOMIC_BLOCK.
+ *
+ * A producer claims the next element with a compare-and-swap of the tail, fills it and publishes it through the sequence
+ * number of its cell. Producers may interrupt each other between claim() and publish(), so the consumer may find the front
+ * claimed but not yet published, front() returns nullptr then. N has to be a power of two.
+ */
+template <typename T, ringbuffer_size_t N>
+class DSMEMPSCRingBuffer {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "the capacity has to be a power of two");
+    static_assert(N <= (ringbuffer_size_t)(~(ringbuffer_size_t)0) / 2, "the capacity exceeds the index range");
+
+private:
+    static constexpr ringbuffer_size_t MASK = N - 1;
+
+    /* a cell is free for position p if its sequence is p, and holds the element of position p if its sequence is p + 1 */
+    struct Cell {
+        T element;
+        ringbuffer_size_t sequence;
+    };
+
+    Cell buffer[N];
+    ringbuffer_size_t head;
+    ringbuffer_size_t tail;
+
+public:
+    DSMEMPSCRingBuffer() : buffer{}, head(0), tail(0) {
+        for(ringbuffer_size_t i = 0; i < N; i++) {
+            this->buffer[i].sequence = i;
+        }
+    }
+
+    /* returns the claimed element and its position for publish(), nullptr if the buffer is full */
+    T* claim(ringbuffer_size_t& position) {
+        while(true) {
+            position = atomic_helper::loadRelaxed(&this->tail);
+            Cell& cell = this->buffer[position & MASK];
+            ringbuffer_size_t sequence = atomic_helper::loadAcquire(&cell.sequence);
+            if(sequence == position) {
+                if(atomic_helper::compareExchange(&this->tail, position, (ringbuffer_size_t)(position + 1))) {
+                    return &cell.element;
+                }
+            } else if((ringbuffer_size_t)(position - sequence) == N - 1 || (ringbuffer_size_t)(position - sequence) == N) {
+                /* '-> the element of the previous round was not consumed yet or not even published, its producer might be
+                 *     the context this interrupted, so waiting for it would never end */
+                return nullptr;
+            }
+            /* '-> another producer claimed the position meanwhile */
+        }
+    }
+
+    void publish(ringbuffer_size_t position) {
+        atomic_helper::storeRelease(&this->buffer[position & MASK].sequence, (ringbuffer_size_t)(position + 1));
+    }
+
+    /* returns nullptr if the next element is not published yet */
+    T* front() {
+        Cell& cell = this->buffer[this->head & MASK];
+        if(atomic_helper::loadAcquire(&cell.sequence) != (ringbuffer_size_t)(this->head + 1)) {
+            return nullptr;
+        }
+        return &cell.element;
+    }
+
+    void pop() {
+        atomic_helper::storeRelease(&this->buffer[this->head & MASK].sequence, (ringbuffer_size_t)(this->head + N));
+        this->head++;
+    }
+};
+
 } /* namespace dsme */
 
 #endif /* DSMERINGBUFFER_H_ */
@@ -90,6 +90,9 @@ public:
     virtual uint8_t getRetryCounter() = 0;
 
     uint8_t queueAtCreation = -1;
+
+    /* priority class of the message in the GTS queue as requested by the upper layer, 0 is the least urgent */
+    uint8_t priority = 0;
 };
 
 } /* namespace dsme */
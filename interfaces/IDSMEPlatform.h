@@ -100,6 +100,14 @@ public:
      */
     virtual void scheduleStartOfCFP() = 0;
 
+    /*
+     * Asks the platform to call DSMELayer::runDeferredTasks() from task context, e.g. from its main loop or idle hook.
+     * Platforms that can not do so return false, the deferred tasks then run right away.
+     */
+    virtual bool scheduleDeferredTasks() {
+        return false;
+    }
+
     /*
      * Beacons with LQI lower than this will not be considered when deciding for a coordinator to associate to
      */
@@ -124,6 +132,12 @@ public:
     virtual void signalQueueLength(uint32_t length) {
     }
 
+    /*
+     * Signal that the GTS queue reached its high watermark (true) or dropped to its low watermark again (false)
+     */
+    virtual void signalQueueWatermark(bool aboveHighWatermark) {
+    }
+
     /*
      * Signal transmitted packets per slot
      */
@@ -51,6 +51,7 @@ enum ACTState { VALID, UNCONFIRMED, INVALID, DEALLOCATED, REMOVED };
 
 class ACTElement {
     friend class DSMEAllocationCounterTable;
+    friend class ACTIterator;
 
 public:
     uint16_t getIdleCounter() const {
@@ -126,8 +127,20 @@ public:
     }
 
 private:
+    ACTElement()
+        : superframeID(0), slotID(0), channel(0), direction(TX), address(0), idleCounter(0), state(INVALID), previousOfNeighbor(0), nextOfNeighbor(0) {
+    }
+
     ACTElement(uint16_t superframeID, uint8_t slotID, uint8_t channel, Direction direction, uint16_t address, ACTState state)
-        : superframeID(superframeID), slotID(slotID), channel(channel), direction(direction), address(address), idleCounter(0), state(state) {
+        : superframeID(superframeID),
+          slotID(slotID),
+          channel(channel),
+          direction(direction),
+          address(address),
+          idleCounter(0),
+          state(state),
+          previousOfNeighbor(0),
+          nextOfNeighbor(0) {
     }
 
     uint16_t superframeID;
@@ -149,6 +162,11 @@ private:
     // since a transmission might induce collisions, but a reception could collect pending messages if
     // the slot on the other device is still VALID.
     ACTState state;
+
+    // Bitmap positions of the neighboring elements with the same address and direction, maintained by the
+    // DSMEAllocationCounterTable. The end of the list is marked by the length of the bitmap.
+    uint16_t previousOfNeighbor;
+    uint16_t nextOfNeighbor;
 };
 
 } /* namespace dsme */
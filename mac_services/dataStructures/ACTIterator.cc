@@ -0,0 +1,91 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "./ACTIterator.h"
+
+#include "../../../dsme_platform.h"
+#include "./BitVectorIterator.h"
+#include "./DSMEAllocationCounterTable.h"
+
+namespace dsme {
+
+ACTIterator::ACTIterator(DSMEAllocationCounterTable* instance, uint16_t position, Order order) : instance(instance), position(position), order(order) {
+}
+
+ACTIterator& ACTIterator::operator++() {
+    if(order == NEIGHBOR_SLOTS) {
+        DSME_ASSERT(position < instance->bitmap.length());
+        position = instance->elements[position].nextOfNeighbor;
+        return *this;
+    }
+
+    BitVectorIterator next((order == RX_SLOTS) ? &instance->rxBitmap : &instance->bitmap, position, true);
+    ++next;
+    position = *next;
+    return *this;
+}
+
+ACTIterator ACTIterator::operator++(int) {
+    ACTIterator old = *this;
+    ++(*this);
+    return old;
+}
+
+ACTElement& ACTIterator::operator*() {
+    DSME_ASSERT(position < instance->bitmap.length());
+    return instance->elements[position];
+}
+
+ACTElement* ACTIterator::operator->() {
+    DSME_ASSERT(position < instance->bitmap.length());
+    return &(instance->elements[position]);
+}
+
+bool ACTIterator::operator==(const ACTIterator& other) const {
+    return (instance == other.instance && position == other.position);
+}
+
+bool ACTIterator::operator!=(const ACTIterator& other) const {
+    return !(*this == other);
+}
+
+} /* namespace dsme */
@@ -0,0 +1,93 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef ACTITERATOR_H_
+#define ACTITERATOR_H_
+
+/* INCLDUDES *****************************************************************/
+
+#include "../../helper/Integers.h"
+
+namespace dsme {
+
+class ACTElement;
+class DSMEAllocationCounterTable;
+
+/**
+ * Iterates over the allocated slots of a DSMEAllocationCounterTable in the order of their
+ * bitmap position, i.e. ordered by superframe and GTS. The iterator stays valid if other
+ * elements are added or removed, and also if the element it points to is removed.
+ *
+ * The other orders only visit a subset in the same order: RX_SLOTS the slots in RX direction,
+ * NEIGHBOR_SLOTS the slots with the same address and direction as the element it points to.
+ * A neighbor iterator stays valid if the element it points to is removed, but not if its
+ * successor is removed as well.
+ */
+class ACTIterator {
+public:
+    enum Order { ALL_SLOTS, RX_SLOTS, NEIGHBOR_SLOTS };
+
+    ACTIterator(DSMEAllocationCounterTable* instance, uint16_t position, Order order = ALL_SLOTS);
+
+    ACTIterator(const ACTIterator&) = default;
+    ACTIterator& operator=(const ACTIterator&) = default;
+
+    ACTIterator& operator++();
+    ACTIterator operator++(int);
+
+    ACTElement& operator*();
+    ACTElement* operator->();
+
+    bool operator==(const ACTIterator&) const;
+    bool operator!=(const ACTIterator&) const;
+
+private:
+    friend class DSMEAllocationCounterTable;
+
+    DSMEAllocationCounterTable* instance;
+    uint16_t position;
+    Order order;
+};
+
+} /* namespace dsme */
+
+#endif /* ACTITERATOR_H_ */
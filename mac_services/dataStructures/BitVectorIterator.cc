@@ -75,13 +75,10 @@ BitVectorIterator& BitVectorIterator::operator=(BitVectorIterator&& other) {
 }
 
 BitVectorIterator& BitVectorIterator::operator++() {
-    uint16_t max = instance->bitSize;
-    if(this->position == max) {
+    if(this->position == instance->bitSize) {
         return *this;
     }
-    this->position++;
-    for(; this->position != max && instance->get(this->position) != value; this->position++) {
-    }
+    this->position = instance->findNext(this->position + 1, value);
     return *this;
 }
 
@@ -0,0 +1,150 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef BITVECTORKERNELS_H_
+#define BITVECTORKERNELS_H_
+
+#include "../../helper/Integers.h"
+#include "./DSMEBitVector.h"
+
+/*
+ * SIMD versions are used for 64 bit words if the target supports them, AVX2 and SSE2 on x86
+ * and NEON on ARM, the portable scalar loop handles the remaining words and all other targets.
+ */
+#if BITVECTOR_WORD_BITS == 64 && defined(__AVX2__)
+#define BITVECTOR_KERNEL_AVX2
+#include <immintrin.h>
+#elif BITVECTOR_WORD_BITS == 64 && defined(__SSE2__)
+#define BITVECTOR_KERNEL_SSE2
+#include <emmintrin.h>
+#elif BITVECTOR_WORD_BITS == 64 && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define BITVECTOR_KERNEL_NEON
+#include <arm_neon.h>
+#endif
+
+namespace dsme {
+
+enum BitVectorOperation { BITVECTOR_COPY, BITVECTOR_JOIN, BITVECTOR_COMPLEMENT };
+
+/*
+ * Combines dst[i] for 0 <= i < numDst with the BITVECTOR_WORD_BITS bits of src that start at
+ * bit offset + i * BITVECTOR_WORD_BITS, where words at index >= numSrc read as zero.
+ * COPY assigns the source bits, JOIN ORs them into dst and COMPLEMENT clears them in dst.
+ */
+template <BitVectorOperation OP>
+inline void combineShifted(bit_vector_word_t* dst, bit_vector_size_t numDst, const bit_vector_word_t* src, bit_vector_size_t numSrc,
+                           bit_vector_size_t offset) {
+    const bit_vector_size_t first = offset / BITVECTOR_WORD_BITS;
+    const bit_vector_size_t shift = offset % BITVECTOR_WORD_BITS;
+    bit_vector_size_t i = 0;
+
+#if defined(BITVECTOR_KERNEL_AVX2)
+    /* lane k of lo is src[first + i + k], lane k of hi is the next source word; shifting by 64 yields zero */
+    const __m128i right = _mm_cvtsi32_si128(shift);
+    const __m128i left = _mm_cvtsi32_si128(BITVECTOR_WORD_BITS - shift);
+    for(; i + 4 <= numDst && first + i + 4 < numSrc; i += 4) {
+        __m256i lo = _mm256_loadu_si256((const __m256i*)(src + first + i));
+        __m256i hi = _mm256_loadu_si256((const __m256i*)(src + first + i + 1));
+        __m256i value = _mm256_or_si256(_mm256_srl_epi64(lo, right), _mm256_sll_epi64(hi, left));
+        __m256i* target = (__m256i*)(dst + i);
+        if(OP == BITVECTOR_COPY) {
+            _mm256_storeu_si256(target, value);
+        } else if(OP == BITVECTOR_JOIN) {
+            _mm256_storeu_si256(target, _mm256_or_si256(_mm256_loadu_si256(target), value));
+        } else {
+            _mm256_storeu_si256(target, _mm256_andnot_si256(value, _mm256_loadu_si256(target)));
+        }
+    }
+#elif defined(BITVECTOR_KERNEL_SSE2)
+    const __m128i right = _mm_cvtsi32_si128(shift);
+    const __m128i left = _mm_cvtsi32_si128(BITVECTOR_WORD_BITS - shift);
+    for(; i + 2 <= numDst && first + i + 2 < numSrc; i += 2) {
+        __m128i lo = _mm_loadu_si128((const __m128i*)(src + first + i));
+        __m128i hi = _mm_loadu_si128((const __m128i*)(src + first + i + 1));
+        __m128i value = _mm_or_si128(_mm_srl_epi64(lo, right), _mm_sll_epi64(hi, left));
+        __m128i* target = (__m128i*)(dst + i);
+        if(OP == BITVECTOR_COPY) {
+            _mm_storeu_si128(target, value);
+        } else if(OP == BITVECTOR_JOIN) {
+            _mm_storeu_si128(target, _mm_or_si128(_mm_loadu_si128(target), value));
+        } else {
+            _mm_storeu_si128(target, _mm_andnot_si128(value, _mm_loadu_si128(target)));
+        }
+    }
+#elif defined(BITVECTOR_KERNEL_NEON)
+    /* NEON shifts right by a negative count, a count of +-64 yields zero */
+    const int64x2_t right = vdupq_n_s64(-(int64_t)shift);
+    const int64x2_t left = vdupq_n_s64(BITVECTOR_WORD_BITS - shift);
+    for(; i + 2 <= numDst && first + i + 2 < numSrc; i += 2) {
+        uint64x2_t lo = vld1q_u64(src + first + i);
+        uint64x2_t hi = vld1q_u64(src + first + i + 1);
+        uint64x2_t value = vorrq_u64(vshlq_u64(lo, right), vshlq_u64(hi, left));
+        if(OP == BITVECTOR_COPY) {
+            vst1q_u64(dst + i, value);
+        } else if(OP == BITVECTOR_JOIN) {
+            vst1q_u64(dst + i, vorrq_u64(vld1q_u64(dst + i), value));
+        } else {
+            vst1q_u64(dst + i, vbicq_u64(vld1q_u64(dst + i), value));
+        }
+    }
+#endif
+
+    for(; i < numDst; i++) {
+        bit_vector_word_t lo = (first + i < numSrc) ? src[first + i] : 0;
+        bit_vector_word_t value = lo >> shift;
+        if(shift != 0 && first + i + 1 < numSrc) {
+            value |= src[first + i + 1] << (BITVECTOR_WORD_BITS - shift);
+        }
+
+        if(OP == BITVECTOR_COPY) {
+            dst[i] = value;
+        } else if(OP == BITVECTOR_JOIN) {
+            dst[i] |= value;
+        } else {
+            dst[i] &= ~value;
+        }
+    }
+}
+
+} /* namespace dsme */
+
+#endif /* BITVECTORKERNELS_H_ */
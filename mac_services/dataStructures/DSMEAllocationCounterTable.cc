@@ -50,6 +50,7 @@
 #include "../DSME_Common.h"
 #include "../pib/MAC_PIB.h"
 #include "./ACTElement.h"
+#include "./ACTIterator.h"
 #include "./BitVectorIterator.h"
 #include "./DSMEBitVector.h"
 #include "./DSMESABSpecification.h"
@@ -59,7 +60,7 @@
 using namespace dsme;
 
 DSMEAllocationCounterTable::DSMEAllocationCounterTable()
-    : numSuperFramesPerMultiSuperframe(0), numGTSlotsFirstSuperframe(0), numGTSlotsLatterSuperframes(0), numChannels(0) {
+    : numSuperFramesPerMultiSuperframe(0), numGTSlotsFirstSuperframe(0), numGTSlotsLatterSuperframes(0), numChannels(0), revision(0), changeBatchDepth(0), changeDeferred(false) {
 }
 
 void DSMEAllocationCounterTable::initialize(uint16_t numSuperFramesPerMultiSuperframe, uint8_t numGTSlotsFirstSuperframe, uint8_t numGTSlotsLatterSuperframes,
@@ -69,7 +70,33 @@ void DSMEAllocationCounterTable::initialize(uint16_t numSuperFramesPerMultiSuper
     this->numGTSlotsLatterSuperframes = numGTSlotsLatterSuperframes;
     this->numChannels = numChannels;
     bitmap.initialize((numGTSlotsFirstSuperframe + (numSuperFramesPerMultiSuperframe - 1) * numGTSlotsLatterSuperframes), false);
+    rxBitmap.initialize(bitmap.length(), false);
     this->dsme = dsme;
+    changed();
+}
+
+void DSMEAllocationCounterTable::changed() {
+    this->revision++;
+    if(this->changeBatchDepth > 0) {
+        this->changeDeferred = true;
+    } else if(this->changeDelegate) {
+        this->changeDelegate();
+    }
+}
+
+void DSMEAllocationCounterTable::beginChanges() {
+    this->changeBatchDepth++;
+}
+
+void DSMEAllocationCounterTable::endChanges() {
+    DSME_ASSERT(this->changeBatchDepth > 0);
+    this->changeBatchDepth--;
+    if(this->changeBatchDepth == 0 && this->changeDeferred) {
+        this->changeDeferred = false;
+        if(this->changeDelegate) {
+            this->changeDelegate();
+        }
+    }
 }
 
 uint16_t DSMEAllocationCounterTable::getBitmapPosition(uint8_t superframeID, uint8_t slotID) const {
@@ -81,34 +108,75 @@ uint16_t DSMEAllocationCounterTable::getBitmapPosition(uint8_t superframeID, uin
 }
 
 DSMEAllocationCounterTable::iterator DSMEAllocationCounterTable::begin() {
-    return act.begin();
+    return iterator(this, *bitmap.beginSetBits());
 }
 
 DSMEAllocationCounterTable::iterator DSMEAllocationCounterTable::end() {
-    return act.end();
+    return iterator(this, bitmap.length());
 }
 
-void DSMEAllocationCounterTable::clear() {
-    while(this->act.size() != 0) {
-        auto it = this->act.begin();
-        this->act.remove(it);
+DSMEAllocationCounterTable::iterator DSMEAllocationCounterTable::lowerBound(uint16_t position) {
+    if(position == 0) {
+        return begin();
+    }
+    if(position >= bitmap.length()) {
+        return end();
     }
+    BitVectorIterator next(&bitmap, position - 1, true);
+    ++next;
+    return iterator(this, *next);
+}
+
+DSMEAllocationCounterTable::iterator DSMEAllocationCounterTable::beginSuperframe(uint16_t superframeID) {
+    if(superframeID >= numSuperFramesPerMultiSuperframe) {
+        return end();
+    }
+    return lowerBound(getBitmapPosition(superframeID, 0));
+}
+
+DSMEAllocationCounterTable::iterator DSMEAllocationCounterTable::endSuperframe(uint16_t superframeID) {
+    return beginSuperframe(superframeID + 1);
+}
+
+DSMEAllocationCounterTable::iterator DSMEAllocationCounterTable::beginRX() {
+    return iterator(this, *rxBitmap.beginSetBits(), iterator::RX_SLOTS);
+}
 
+void DSMEAllocationCounterTable::clear() {
     for(int i = 0; i < 2; i++) {
-        while(this->numAllocatedSlots[i].size() != 0) {
-            auto it = this->numAllocatedSlots[i].begin();
-            this->numAllocatedSlots[i].remove(it);
+        while(this->neighborSlots[i].size() != 0) {
+            auto it = this->neighborSlots[i].begin();
+            this->neighborSlots[i].remove(it);
         }
     }
 
     this->bitmap.fill(false);
+    this->rxBitmap.fill(false);
+    changed();
 }
 
 DSMEAllocationCounterTable::iterator DSMEAllocationCounterTable::find(uint16_t superframeID, uint8_t gtSlotID) {
-    ACTPosition pos;
-    pos.superframeID = superframeID;
-    pos.gtSlotID = gtSlotID;
-    return act.find(pos);
+    if(superframeID >= numSuperFramesPerMultiSuperframe) {
+        return end();
+    }
+    if(gtSlotID >= ((superframeID == 0) ? numGTSlotsFirstSuperframe : numGTSlotsLatterSuperframes)) {
+        return end();
+    }
+
+    uint16_t position = getBitmapPosition(superframeID, gtSlotID);
+    if(!bitmap.get(position)) {
+        return end();
+    }
+    return iterator(this, position);
+}
+
+DSMEAllocationCounterTable::iterator DSMEAllocationCounterTable::beginNeighbor(uint16_t address, Direction direction) {
+    int d = (direction == TX) ? 0 : 1;
+    RBTree<ACTNeighborSlots, uint16_t, MAX_NEIGHBORS>::iterator slotsIt = neighborSlots[d].find(address);
+    if(slotsIt == neighborSlots[d].end()) {
+        return end();
+    }
+    return iterator(this, slotsIt->first, iterator::NEIGHBOR_SLOTS);
 }
 
 void DSMEAllocationCounterTable::printChange(const char* type, uint16_t superframeID, uint8_t gtSlotID, uint8_t channel, bool direction, uint16_t address) {
@@ -136,32 +204,67 @@ bool DSMEAllocationCounterTable::add(uint16_t superframeID, uint8_t gtSlotID, ui
     }
     DSME_ASSERT(!isAllocated(superframeID, gtSlotID));
 
-    ACTPosition pos;
-    pos.superframeID = superframeID;
-    pos.gtSlotID = gtSlotID;
-    bool success = act.insert(ACTElement(superframeID, gtSlotID, channel, direction, address, state), pos);
+    uint16_t position = getBitmapPosition(superframeID, gtSlotID);
+    bool success = !bitmap.get(position);
+
+    int d = (direction == TX) ? 0 : 1;
+    RBTree<ACTNeighborSlots, uint16_t, MAX_NEIGHBORS>::iterator slotsIt = neighborSlots[d].find(address);
+    if(success && slotsIt == neighborSlots[d].end()) {
+        /* '-> first slot with this address, make room for it before anything is changed */
+        LOG_DEBUG("Inserting 0x" << HEXOUT << address << DECOUT << " into neighborSlots[" << d << ".");
+        ACTNeighborSlots slots;
+        slots.count = 1;
+        slots.first = position;
+        success = neighborSlots[d].insert(slots, address);
+        if(!success) {
+            /* '-> already MAX_NEIGHBORS addresses hold slots in this direction */
+            LOG_ERROR("No room to allocate a slot with 0x" << HEXOUT << address << DECOUT << ".");
+        }
+    } else if(success) {
+        slotsIt->count++;
+    }
 
     if(success) {
+        elements[position] = ACTElement(superframeID, gtSlotID, channel, direction, address, state);
+
         this->dsme->getPlatform().signalGTSChange(false, IEEE802154MacAddress(address));
 
-        int d = (direction == TX) ? 0 : 1;
-        RBTree<uint16_t, uint16_t>::iterator numSlotIt = numAllocatedSlots[d].find(address);
-        if(numSlotIt == numAllocatedSlots[d].end()) {
-            LOG_DEBUG("Inserting 0x" << HEXOUT << address << DECOUT << " into numAllocatedSlots[" << d << ".");
-            numAllocatedSlots[d].insert(1, address);
+        if(slotsIt == neighborSlots[d].end()) {
+            /* '-> inserted above */
+            elements[position].previousOfNeighbor = bitmap.length();
+            elements[position].nextOfNeighbor = bitmap.length();
         } else {
-            (*numSlotIt)++;
-            LOG_DEBUG("Incrementing slot count " << d << HEXOUT << " for 0x" << address << DECOUT << " (now at " << *numSlotIt << ").");
+            LOG_DEBUG("Incrementing slot count " << d << HEXOUT << " for 0x" << address << DECOUT << " (now at " << slotsIt->count << ").");
+
+            /* keep the neighbor list ordered by bitmap position */
+            uint16_t previous = bitmap.length();
+            uint16_t next = slotsIt->first;
+            while(next < position) {
+                previous = next;
+                next = elements[next].nextOfNeighbor;
+            }
+            elements[position].previousOfNeighbor = previous;
+            elements[position].nextOfNeighbor = next;
+            if(previous == bitmap.length()) {
+                slotsIt->first = position;
+            } else {
+                elements[previous].nextOfNeighbor = position;
+            }
+            if(next != bitmap.length()) {
+                elements[next].previousOfNeighbor = position;
+            }
         }
 
-        bitmap.set(getBitmapPosition(superframeID, gtSlotID), true);
+        bitmap.set(position, true);
+        rxBitmap.set(position, direction == RX);
+        changed();
     }
 
     return success;
 }
 
 void DSMEAllocationCounterTable::remove(DSMEAllocationCounterTable::iterator it) {
-    DSME_ASSERT(it != act.end());
+    DSME_ASSERT(it != end());
 
     uint16_t superframeID = it->getSuperframeID();
     uint8_t gtSlotID = it->getGTSlotID();
@@ -172,18 +275,30 @@ void DSMEAllocationCounterTable::remove(DSMEAllocationCounterTable::iterator it)
 
     DSME_ASSERT(isAllocated(superframeID, gtSlotID));
 
-    bitmap.set(getBitmapPosition(superframeID, gtSlotID), false);
+    DSME_ASSERT(it.position == getBitmapPosition(superframeID, gtSlotID));
 
     int d = (it->direction == TX) ? 0 : 1;
-    RBTree<uint16_t, uint16_t>::iterator numSlotIt = numAllocatedSlots[d].find(it->address);
-    DSME_ASSERT(numSlotIt != numAllocatedSlots[d].end());
-    (*numSlotIt)--;
-    LOG_DEBUG("Decrementing slot count for " << it->address << DECOUT << " (now at " << *numSlotIt << ").");
-    if((*numSlotIt) == 0) {
-        numAllocatedSlots[d].remove(numSlotIt);
+    RBTree<ACTNeighborSlots, uint16_t, MAX_NEIGHBORS>::iterator slotsIt = neighborSlots[d].find(it->address);
+    DSME_ASSERT(slotsIt != neighborSlots[d].end());
+    slotsIt->count--;
+    LOG_DEBUG("Decrementing slot count for " << it->address << DECOUT << " (now at " << slotsIt->count << ").");
+    if(slotsIt->count == 0) {
+        neighborSlots[d].remove(slotsIt);
+    } else {
+        /* the links of the removed element are kept, so a neighbor iterator pointing to it can still advance */
+        if(it->previousOfNeighbor == bitmap.length()) {
+            slotsIt->first = it->nextOfNeighbor;
+        } else {
+            elements[it->previousOfNeighbor].nextOfNeighbor = it->nextOfNeighbor;
+        }
+        if(it->nextOfNeighbor != bitmap.length()) {
+            elements[it->nextOfNeighbor].previousOfNeighbor = it->previousOfNeighbor;
+        }
     }
 
-    act.remove(it);
+    bitmap.set(it.position, false);
+    rxBitmap.set(it.position, false);
+    changed();
 }
 
 bool DSMEAllocationCounterTable::isAllocated(uint16_t superframeID, uint8_t gtSlotID) const {
@@ -193,11 +308,11 @@ bool DSMEAllocationCounterTable::isAllocated(uint16_t superframeID, uint8_t gtSl
 
 uint16_t DSMEAllocationCounterTable::getNumAllocatedGTS(uint16_t address, Direction direction) {
     int d = (direction == TX) ? 0 : 1;
-    RBTree<uint16_t, uint16_t>::iterator numSlotIt = numAllocatedSlots[d].find(address);
-    if(numSlotIt == numAllocatedSlots[d].end()) {
+    RBTree<ACTNeighborSlots, uint16_t, MAX_NEIGHBORS>::iterator slotsIt = neighborSlots[d].find(address);
+    if(slotsIt == neighborSlots[d].end()) {
         return 0;
     } else {
-        return *numSlotIt;
+        return slotsIt->count;
     }
 }
 
@@ -236,6 +351,7 @@ void DSMEAllocationCounterTable::setACTState(DSMESABSpecification& subBlock, ACT
     }
     DSME_ASSERT(subBlock.getSubBlock().count(true) == 1);
 
+    beginChanges();
     for(DSMESABSpecification::SABSubBlock::iterator it = subBlock.getSubBlock().beginSetBits(); it != subBlock.getSubBlock().endSetBits(); ++it) {
         // this calculation assumes there is always exactly one superframe in the subblock
         GTS gts(subBlock.getSubBlockIndex(), (*it) / numChannels, (*it) % numChannels);
@@ -273,8 +389,10 @@ void DSMEAllocationCounterTable::setACTState(DSMESABSpecification& subBlock, ACT
             if(deviceAddress != 0xFFFF) {
                 uint16_t channel = useChannelOffset ? channelOffset : gts.channel;
                 LOG_DEBUG("ch " << channelOffset << " " << gts.channel);
-                bool added = add(gts.superframeID, gts.slotID, channel, direction, deviceAddress, state);
-                DSME_ASSERT(added);
+                if(!add(gts.superframeID, gts.slotID, channel, direction, deviceAddress, state)) {
+                    /* '-> the table is full, the slot stays unused and is deallocated by the other side once it idles */
+                    continue;
+                }
                 LOG_DEBUG("add slot " << (uint16_t)gts.slotID << " " << (uint16_t)gts.superframeID << " " << channel << " as " << stateToString(state)
                                       << " useChannelOffset: " << useChannelOffset << " nDirection: " << direction);
             } else {
@@ -286,4 +404,5 @@ void DSMEAllocationCounterTable::setACTState(DSMESABSpecification& subBlock, ACT
             actit->setState(state);
         }
     }
+    endChanges();
 }
@@ -44,49 +44,33 @@
 #define DSMEALLOCATIONCOUNTERTABLE_H_
 
 #include "../../../dsme_settings.h"
+#include "../../helper/DSMEDelegate.h"
 #include "../../interfaces/IDSMEPlatform.h"
 #include "./ACTElement.h"
+#include "./ACTIterator.h"
 #include "./DSMEBitVector.h"
 #include "./DSMESABSpecification.h"
 #include "./RBTree.h"
 
 namespace dsme {
 
-struct ACTPosition {
-    uint16_t superframeID;
-    uint8_t gtSlotID;
-
-    bool operator>(const ACTPosition& other) const {
-        if(this->superframeID > other.superframeID) {
-            return true;
-        }
-        if(this->superframeID < other.superframeID) {
-            return false;
-        }
-        return this->gtSlotID > other.gtSlotID;
-    }
+class DSMELayer;
 
-    bool operator<(const ACTPosition& other) const {
-        if(this->superframeID < other.superframeID) {
-            return true;
-        }
-        if(this->superframeID > other.superframeID) {
-            return false;
-        }
-        return this->gtSlotID < other.gtSlotID;
+/* number of slots and first element of the neighbor list of one address and direction */
+struct ACTNeighborSlots {
+    ACTNeighborSlots() : count(0), first(0) {
     }
 
-    bool operator==(const ACTPosition& other) const {
-        return ((superframeID == other.superframeID) && (gtSlotID == other.gtSlotID));
-    }
+    uint16_t count;
+    uint16_t first;
 };
 
-class DSMELayer;
-
 // own allocated slots
 class DSMEAllocationCounterTable {
+    friend class ACTIterator;
+
 public:
-    typedef RBTree<ACTElement, ACTPosition>::iterator iterator;
+    typedef ACTIterator iterator;
     typedef bool (*condition_t)(ACTElement);
 
     DSMEAllocationCounterTable();
@@ -102,6 +86,17 @@ public:
 
     iterator find(uint16_t superframeID, uint8_t gtSlotID);
 
+    /* the slots allocated in the given superframe, ends at endSuperframe(superframeID) */
+    iterator beginSuperframe(uint16_t superframeID);
+
+    iterator endSuperframe(uint16_t superframeID);
+
+    /* the slots allocated in RX direction, ordered like begin(); ends at end() */
+    iterator beginRX();
+
+    /* the slots allocated with the given address in the given direction, ordered like begin(); ends at end() */
+    iterator beginNeighbor(uint16_t address, Direction direction);
+
     void printChange(const char* type, uint16_t superframeID, uint8_t gtSlotID, uint8_t channel, bool direction, uint16_t address);
 
     bool add(uint16_t superframeID, uint8_t gtSlotID, uint8_t channel, Direction direction, uint16_t address, ACTState state);
@@ -112,6 +107,20 @@ public:
 
     uint16_t getNumAllocatedGTS(uint16_t address, Direction direction);
 
+    /* changes whenever a slot is added or removed */
+    uint16_t getRevision() const {
+        return revision;
+    }
+
+    /* called after every change of the revision, so derived data can be rebuilt where the table changes */
+    void setChangeDelegate(Delegate<void()> delegate) {
+        this->changeDelegate = delegate;
+    }
+
+    /* defers the change delegate to the matching endChanges(), so a batch of changes is announced once */
+    void beginChanges();
+    void endChanges();
+
     void setACTState(DSMESABSpecification& subBlock, ACTState state, Direction direction, uint16_t deviceAddress, uint16_t channelOffset, bool useChannelOffset,
                      bool checkAddress = false);
     void setACTState(DSMESABSpecification& subBlock, ACTState state, Direction direction, uint16_t deviceAddress, uint16_t channelOffset, bool useChannelOffset,
@@ -122,16 +131,29 @@ private:
     DSMEAllocationCounterTable(const DSMEAllocationCounterTable& other) = delete;
     uint16_t getBitmapPosition(uint8_t superframeID, uint8_t slotID) const;
 
+    /* the first allocated slot at or after the given bitmap position */
+    iterator lowerBound(uint16_t position);
+
+    void changed();
+
     uint16_t numSuperFramesPerMultiSuperframe;
     uint8_t numGTSlotsFirstSuperframe;
     uint8_t numGTSlotsLatterSuperframes;
     uint8_t numChannels;
+    uint16_t revision;
+    Delegate<void()> changeDelegate;
+    uint8_t changeBatchDepth;
+    bool changeDeferred;
 
+    /* an element is only valid if its bit in the bitmap is set, both are indexed by getBitmapPosition() */
     BitVector<MAX_SUPERFRAMES_PER_MULTI_SUPERFRAME * MAX_GTSLOTS> bitmap;
-    RBTree<ACTElement, ACTPosition> act;
+    ACTElement elements[MAX_SUPERFRAMES_PER_MULTI_SUPERFRAME * MAX_GTSLOTS];
+
+    /* the subset of bitmap that holds the slots in RX direction */
+    BitVector<MAX_SUPERFRAMES_PER_MULTI_SUPERFRAME * MAX_GTSLOTS> rxBitmap;
 
     // TODO integrate this nicely into the NeighborQueue
-    RBTree<uint16_t, uint16_t> numAllocatedSlots[2]; // 0 == TX, 1 == RX
+    RBTree<ACTNeighborSlots, uint16_t, MAX_NEIGHBORS> neighborSlots[2]; // 0 == TX, 1 == RX
 
     DSMELayer* dsme;
 };
@@ -44,15 +44,52 @@
 
 #include "./DSMEBitVector.h"
 
+#include "../../helper/BitOperations.h"
+#include "./BitVectorKernels.h"
 #include "./Serializer.h"
 
 #include "../../../dsme_platform.h"
 
 namespace dsme {
 
+/* DEFINES *******************************************************************/
+
+#define WORD_BITS BITVECTOR_WORD_BITS
+#define BYTES_PER_WORD (BITVECTOR_WORD_BITS / 8)
+#define ALL_ONES (~(bit_vector_word_t)0)
+
+/* HELPER FUNCTIONS **********************************************************/
+
+/* shifts the source words to bit position myOffset of the destination and merges them into the destination words they overlap */
+template <BitVectorOperation OP>
+static void mergeShifted(bit_vector_word_t* words, bit_vector_size_t numWords, const bit_vector_word_t* source, bit_vector_size_t sourceBits,
+                         bit_vector_size_t myOffset) {
+    bit_vector_size_t shift = myOffset % WORD_BITS;
+    bit_vector_size_t first = myOffset / WORD_BITS;
+    bit_vector_size_t last = first + BITVECTOR_WORD_LENGTH(shift + sourceBits);
+    if(last > numWords) {
+        last = numWords;
+    }
+    if(sourceBits == 0 || first >= last) {
+        return;
+    }
+
+    if(shift == 0) {
+        combineShifted<OP>(words + first, last - first, source, BITVECTOR_WORD_LENGTH(sourceBits), 0);
+    } else {
+        /* the first word only receives the low bits of the first source word, all following ones straddle two source words */
+        if(OP == BITVECTOR_JOIN) {
+            words[first] |= source[0] << shift;
+        } else {
+            words[first] &= ~(source[0] << shift);
+        }
+        combineShifted<OP>(words + first + 1, last - first - 1, source, BITVECTOR_WORD_LENGTH(sourceBits), WORD_BITS - shift);
+    }
+}
+
 /* CONSTRUCTORS & DESTRUCTOR *************************************************/
 
-BitVectorBase::BitVectorBase(uint8_t* byte_array) : bitSize(0), byte_array(byte_array), endSetIterator(this, 0, true), endUnsetIterator(this, 0, false) {
+BitVectorBase::BitVectorBase(bit_vector_word_t* words) : bitSize(0), words(words), endSetIterator(this, 0, true), endUnsetIterator(this, 0, false) {
 }
 
 void BitVectorBase::initialize(bit_vector_size_t bitSize, bool initial_fill) {
@@ -62,18 +99,15 @@ void BitVectorBase::initialize(bit_vector_size_t bitSize, bool initial_fill) {
     this->fill(initial_fill);
 }
 
-BitVectorBase::BitVectorBase(uint8_t* byte_array, const BitVectorBase& other)
-    : bitSize(other.bitSize), byte_array(byte_array), endSetIterator(this, other.bitSize, true), endUnsetIterator(this, other.bitSize, false) {
+BitVectorBase::BitVectorBase(bit_vector_word_t* words, const BitVectorBase& other)
+    : bitSize(other.bitSize), words(words), endSetIterator(this, other.bitSize, true), endUnsetIterator(this, other.bitSize, false) {
     this->copyFrom(other);
 }
 
 /* PUBLIC METHODS ************************************************************/
 
 BitVectorBase::iterator BitVectorBase::beginSetBits() {
-    bit_vector_size_t currentpos = 0;
-    for(currentpos = 0; currentpos < this->bitSize && !this->get(currentpos); currentpos++) {
-    }
-    return iterator(this, currentpos, true);
+    return iterator(this, findNext(0, true), true);
 }
 
 const BitVectorBase::iterator BitVectorBase::endSetBits() const {
@@ -81,10 +115,7 @@ const BitVectorBase::iterator BitVectorBase::endSetBits() const {
 }
 
 BitVectorBase::iterator BitVectorBase::beginUnsetBits() {
-    bit_vector_size_t currentpos = 0;
-    for(currentpos = 0; currentpos < this->bitSize && this->get(currentpos); currentpos++) {
-    }
-    return iterator(this, currentpos, false);
+    return iterator(this, findNext(0, false), false);
 }
 
 const BitVectorBase::iterator BitVectorBase::endUnsetBits() const {
@@ -92,9 +123,10 @@ const BitVectorBase::iterator BitVectorBase::endUnsetBits() const {
 }
 
 void BitVectorBase::fill(bool value) {
-    for(uint16_t i = 0; i < BITVECTOR_BYTE_LENGTH(this->bitSize); i++) {
-        this->byte_array[i] = value * 0xFF;
+    for(bit_vector_size_t i = 0; i < numWords(); i++) {
+        this->words[i] = value ? ALL_ONES : 0;
     }
+    clearTail();
 }
 
 void BitVectorBase::set(bit_vector_size_t position, bool value) {
@@ -104,10 +136,11 @@ void BitVectorBase::set(bit_vector_size_t position, bool value) {
         return;
     }
 
+    bit_vector_word_t mask = (bit_vector_word_t)1 << (position % WORD_BITS);
     if(value) {
-        this->byte_array[position >> 3] |= (1 << (position & 0x07));
+        this->words[position / WORD_BITS] |= mask;
     } else {
-        this->byte_array[position >> 3] &= ~(1 << (position & 0x07));
+        this->words[position / WORD_BITS] &= ~mask;
     }
 }
 
@@ -118,7 +151,7 @@ bool BitVectorBase::get(bit_vector_size_t position) const {
         return false;
     }
 
-    return (this->byte_array[position >> 3] & (1 << (position & 0x07)));
+    return (this->words[position / WORD_BITS] >> (position % WORD_BITS)) & 1;
 }
 
 bit_vector_size_t BitVectorBase::length() const {
@@ -132,23 +165,8 @@ void BitVectorBase::copyFrom(const BitVectorBase& other, bit_vector_size_t their
         return;
     }
 
-    if((theirOffset % 8) == 0) {
-        bit_vector_size_t fullBytes = BITVECTOR_BYTE_LENGTH(this->bitSize + 1) - 1;
-        bit_vector_size_t offsetByte = (theirOffset / 8);
-
-        for(bit_vector_size_t i = 0; i < fullBytes; i++) {
-            this->byte_array[i] = other.byte_array[offsetByte + i];
-        }
-
-        for(bit_vector_size_t i = (fullBytes * 8); i < this->bitSize; i++) {
-            this->set(i, other.get((offsetByte * 8) + i));
-        }
-    } else {
-        for(bit_vector_size_t i = 0; i < this->bitSize; i++) {
-            this->set(i, other.get(theirOffset + i));
-        }
-    }
-    return;
+    combineShifted<BITVECTOR_COPY>(this->words, numWords(), other.words, other.numWords(), theirOffset);
+    clearTail();
 }
 
 void BitVectorBase::setOperationJoin(const BitVectorBase& other, bit_vector_size_t myOffset) {
@@ -158,23 +176,8 @@ void BitVectorBase::setOperationJoin(const BitVectorBase& other, bit_vector_size
         return;
     }
 
-    if((myOffset % 8) == 0) {
-        bit_vector_size_t fullBytes = BITVECTOR_BYTE_LENGTH(other.bitSize + 1) - 1;
-        bit_vector_size_t offsetByte = (myOffset / 8);
-
-        for(bit_vector_size_t i = 0; i < fullBytes; i++) {
-            this->byte_array[offsetByte + i] |= other.byte_array[i];
-        }
-
-        for(bit_vector_size_t i = (fullBytes * 8); i < other.bitSize; i++) {
-            this->set((offsetByte * 8) + i, this->get((offsetByte * 8) + i) || other.get(i));
-        }
-    } else {
-        for(bit_vector_size_t i = 0; i < other.bitSize; i++) {
-            this->set(myOffset + i, this->get(myOffset + i) || other.get(i));
-        }
-    }
-    return;
+    mergeShifted<BITVECTOR_JOIN>(this->words, numWords(), other.words, other.bitSize, myOffset);
+    clearTail();
 }
 
 void BitVectorBase::setOperationComplement(const BitVectorBase& other, bit_vector_size_t myOffset) {
@@ -184,63 +187,29 @@ void BitVectorBase::setOperationComplement(const BitVectorBase& other, bit_vecto
         return;
     }
 
-    if((myOffset % 8) == 0) {
-        bit_vector_size_t fullBytes = BITVECTOR_BYTE_LENGTH(other.bitSize + 1) - 1;
-        bit_vector_size_t offsetByte = (myOffset / 8);
-
-        for(bit_vector_size_t i = 0; i < fullBytes; i++) {
-            this->byte_array[offsetByte + i] &= ~other.byte_array[i];
-        }
-
-        for(bit_vector_size_t i = (fullBytes * 8); i < other.bitSize; i++) {
-            this->set((offsetByte * 8) + i, this->get((offsetByte * 8) + i) && !other.get(i));
-        }
-    } else {
-        for(bit_vector_size_t i = 0; i < other.bitSize; i++) {
-            this->set(myOffset + i, this->get(myOffset + i) && !other.get(i));
-        }
-    }
-    return;
+    mergeShifted<BITVECTOR_COMPLEMENT>(this->words, numWords(), other.words, other.bitSize, myOffset);
 }
 
 bool BitVectorBase::isZero() const {
-    bit_vector_size_t fullBytes = BITVECTOR_BYTE_LENGTH(this->bitSize + 1) - 1;
-
-    for(bit_vector_size_t i = 0; i < fullBytes; i++) {
-        if(byte_array[i] != 0) {
-            return false;
-        }
-    }
-
-    for(bit_vector_size_t i = (fullBytes * 8); i < this->bitSize; i++) {
-        if(this->get(i)) {
+    for(bit_vector_size_t i = 0; i < numWords(); i++) {
+        if(words[i] != 0) {
             return false;
         }
     }
-
     return true;
 }
 
 bit_vector_size_t BitVectorBase::count(bool value) const {
     bit_vector_size_t count = 0;
-    bit_vector_size_t fullBytes = BITVECTOR_BYTE_LENGTH(this->bitSize + 1) - 1;
-
-    for(bit_vector_size_t i = 0; i < fullBytes; i++) {
-        uint8_t x = this->byte_array[i];
-        if(!value) {
-            x = ~x;
-        }
-        while(x > 0) {
-            count++;
-            x &= x - 1; // Wegner (1960)
-        }
+    for(bit_vector_size_t i = 0; i < numWords(); i++) {
+        count += popcount(this->words[i]);
     }
 
-    for(bit_vector_size_t i = (fullBytes * 8); i < this->bitSize; i++) {
-        count += this->get(i) ^ (!value);
+    if(value) {
+        return count;
+    } else {
+        return this->bitSize - count;
     }
-
-    return count;
 }
 
 bool BitVectorBase::operator==(const BitVectorBase& other) const {
@@ -248,16 +217,8 @@ bool BitVectorBase::operator==(const BitVectorBase& other) const {
         return false;
     }
 
-    bit_vector_size_t fullBytes = BITVECTOR_BYTE_LENGTH(this->bitSize + 1) - 1;
-
-    for(bit_vector_size_t i = 0; i < fullBytes; i++) {
-        if(this->byte_array[i] != other.byte_array[i]) {
-            return false;
-        }
-    }
-
-    for(bit_vector_size_t i = (fullBytes * 8); i < this->bitSize; i++) {
-        if(this->get(i) != other.get(i)) {
+    for(bit_vector_size_t i = 0; i < numWords(); i++) {
+        if(this->words[i] != other.words[i]) {
             return false;
         }
     }
@@ -273,9 +234,59 @@ uint8_t BitVectorBase::getSerializationLength() const {
     return BITVECTOR_BYTE_LENGTH(bitSize);
 }
 
+/* PROTECTED METHODS *********************************************************/
+
+void BitVectorBase::clearTail() {
+    if(this->bitSize % WORD_BITS != 0) {
+        this->words[this->bitSize / WORD_BITS] &= ALL_ONES >> (WORD_BITS - (this->bitSize % WORD_BITS));
+    }
+}
+
+bit_vector_size_t BitVectorBase::findNext(bit_vector_size_t start, bool value) const {
+    if(start >= this->bitSize) {
+        return this->bitSize;
+    }
+
+    /* skip whole words without a match, the first match in a word is found by counting trailing zeros */
+    bit_vector_size_t index = start / WORD_BITS;
+    bit_vector_word_t word = value ? this->words[index] : ~this->words[index];
+    word &= ALL_ONES << (start % WORD_BITS);
+
+    while(word == 0) {
+        index++;
+        if(index >= numWords()) {
+            return this->bitSize;
+        }
+        word = value ? this->words[index] : ~this->words[index];
+    }
+
+    bit_vector_size_t position = index * WORD_BITS + countTrailingZeros(word);
+    /* '-> unset bits are also found in the unused tail of the last word */
+    return (position < this->bitSize) ? position : this->bitSize;
+}
+
 Serializer& operator<<(Serializer& serializer, const BitVectorBase& bv) {
     for(bit_vector_size_t i = 0; i < BITVECTOR_BYTE_LENGTH(bv.bitSize); i++) {
-        serializer << bv.byte_array[i];
+        bit_vector_size_t index = i / BYTES_PER_WORD;
+        bit_vector_size_t shift = (i % BYTES_PER_WORD) * 8;
+
+        if(index >= bv.numWords()) {
+            /* '-> only reached for an empty vector that is still serialized with one byte */
+            uint8_t empty = 0;
+            serializer << empty;
+            continue;
+        }
+
+        uint8_t byte = bv.words[index] >> shift;
+        serializer << byte;
+        if(serializer.getType() == DESERIALIZATION) {
+            bv.words[index] = (bv.words[index] & ~((bit_vector_word_t)0xFF << shift)) | ((bit_vector_word_t)byte << shift);
+        }
+    }
+
+    if(serializer.getType() == DESERIALIZATION) {
+        /* the bits of the last byte beyond the length are not part of the vector */
+        const_cast<BitVectorBase&>(bv).clearTail();
     }
 
     return serializer;
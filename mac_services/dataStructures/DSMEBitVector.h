@@ -55,17 +55,39 @@ class Serializer;
 
 #define BITVECTOR_BYTE_LENGTH(len) (((len - 1) / 8) + 1)
 
+/* the bits are stored in 64 bit words on 64 bit targets and in 32 bit words otherwise */
+#if !defined(BITVECTOR_WORD_BITS)
+#if UINTPTR_MAX > 0xFFFFFFFFu
+#define BITVECTOR_WORD_BITS 64
+#else
+#define BITVECTOR_WORD_BITS 32
+#endif
+#endif
+
+#define BITVECTOR_WORD_LENGTH(len) (((len) + BITVECTOR_WORD_BITS - 1) / BITVECTOR_WORD_BITS)
+
 /* CLASSES *******************************************************************/
 
 namespace dsme {
 
+#if BITVECTOR_WORD_BITS == 64
+typedef uint64_t bit_vector_word_t;
+#else
+typedef uint32_t bit_vector_word_t;
+#endif
+
+/*
+ * Bit i is stored in bit (i % BITVECTOR_WORD_BITS) of word (i / BITVECTOR_WORD_BITS).
+ * All bits at positions >= length() are kept zero, so whole words can be counted and compared.
+ * The serialized form is independent of the word size: bit i is bit (i % 8) of byte (i / 8).
+ */
 class BitVectorBase {
     friend class BitVectorIterator;
 
 public:
     typedef BitVectorIterator iterator;
 
-    explicit BitVectorBase(uint8_t* byte_array);
+    explicit BitVectorBase(bit_vector_word_t* words);
 
     void initialize(bit_vector_size_t bitSize, bool initial_fill = false);
 
@@ -101,12 +123,22 @@ public:
 
 protected:
     bit_vector_size_t bitSize;
-    uint8_t* const byte_array;
+    bit_vector_word_t* const words;
 
     iterator endSetIterator;
     iterator endUnsetIterator;
 
-    BitVectorBase(uint8_t* byte_array, const BitVectorBase& other);
+    BitVectorBase(bit_vector_word_t* words, const BitVectorBase& other);
+
+    bit_vector_size_t numWords() const {
+        return BITVECTOR_WORD_LENGTH(bitSize);
+    }
+
+    /* clears the unused bits of the last word */
+    void clearTail();
+
+    /* the first position >= start whose bit equals value, length() if there is none */
+    bit_vector_size_t findNext(bit_vector_size_t start, bool value) const;
 
     friend Serializer& operator<<(Serializer& serializer, const BitVectorBase& bv);
 };
@@ -143,7 +175,7 @@ public:
     }
 
 private:
-    uint8_t array[BITVECTOR_BYTE_LENGTH(MAX_SIZE)];
+    bit_vector_word_t array[BITVECTOR_WORD_LENGTH(MAX_SIZE)];
 };
 
 } /* namespace dsme */
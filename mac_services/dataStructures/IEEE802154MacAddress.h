@@ -47,132 +47,165 @@
 
 namespace dsme {
 
+/**
+ * Extended address packed into a single integer, a1 being the most significant word. This makes equality and ordering
+ * (which is the lexicographic order of a1 .. a4) single comparisons and provides a ready-made hash key.
+ */
 class IEEE802154MacAddress {
 public:
-    IEEE802154MacAddress(const IEEE802154MacAddress& other);
+    IEEE802154MacAddress(const IEEE802154MacAddress& other) : value(other.value) {
+    }
 
-    IEEE802154MacAddress();
+    IEEE802154MacAddress() : value(0) {
+    }
 
-    explicit IEEE802154MacAddress(uint16_t shortPart);
+    explicit IEEE802154MacAddress(uint16_t shortPart) : value(SHORT_ADDRESS_PREFIX | shortPart) {
+    }
 
-    explicit IEEE802154MacAddress(const uint16_t* a);
+    explicit IEEE802154MacAddress(const uint16_t* a) : value(pack(a[0], a[1], a[2], a[3])) {
+    }
 
-    explicit IEEE802154MacAddress(uint16_t a1, uint16_t a2, uint16_t a3, uint16_t a4);
+    explicit IEEE802154MacAddress(uint16_t a1, uint16_t a2, uint16_t a3, uint16_t a4) : value(pack(a1, a2, a3, a4)) {
+    }
 
     static const IEEE802154MacAddress UNSPECIFIED;
     static constexpr uint16_t SHORT_BROADCAST_ADDRESS{0xffff}; // there is no extended broadcast address (IEEE 802.15.4-2011 5.1.6.2)
     static constexpr uint16_t NO_SHORT_ADDRESS{0xfffe};
 
     uint16_t a1() const {
-        return addr[0];
+        return this->value >> 48;
     }
     uint16_t a2() const {
-        return addr[1];
+        return this->value >> 32;
     }
     uint16_t a3() const {
-        return addr[2];
+        return this->value >> 16;
     }
     uint16_t a4() const {
-        return addr[3];
+        return this->value;
     }
 
     void setA1(uint16_t a) {
-        addr[0] = a;
+        this->value = (this->value & ~(WORD_MASK << 48)) | ((uint64_t)a << 48);
     }
     void setA2(uint16_t a) {
-        addr[1] = a;
+        this->value = (this->value & ~(WORD_MASK << 32)) | ((uint64_t)a << 32);
     }
     void setA3(uint16_t a) {
-        addr[2] = a;
+        this->value = (this->value & ~(WORD_MASK << 16)) | ((uint64_t)a << 16);
     }
     void setA4(uint16_t a) {
-        addr[3] = a;
+        this->value = (this->value & ~WORD_MASK) | a;
     }
 
     IEEE802154MacAddress& operator=(IEEE802154MacAddress const& other) {
-        addr[0] = other.a1();
-        addr[1] = other.a2();
-        addr[2] = other.a3();
-        addr[3] = other.a4();
+        this->value = other.value;
         return *this;
     }
 
-    bool operator<=(const IEEE802154MacAddress& other) const;
+    bool operator<=(const IEEE802154MacAddress& other) const {
+        return this->value <= other.value;
+    }
 
-    bool operator>=(const IEEE802154MacAddress& other) const;
+    bool operator>=(const IEEE802154MacAddress& other) const {
+        return this->value >= other.value;
+    }
 
-    bool operator>(const IEEE802154MacAddress& other) const;
+    bool operator>(const IEEE802154MacAddress& other) const {
+        return this->value > other.value;
+    }
 
-    bool operator<(const IEEE802154MacAddress& other) const;
+    bool operator<(const IEEE802154MacAddress& other) const {
+        return this->value < other.value;
+    }
 
-    bool operator==(const IEEE802154MacAddress& other) const;
+    bool operator==(const IEEE802154MacAddress& other) const {
+        return this->value == other.value;
+    }
 
-    bool operator!=(const IEEE802154MacAddress& other) const;
+    bool operator!=(const IEEE802154MacAddress& other) const {
+        return this->value != other.value;
+    }
 
     bool isUnspecified() const {
-        return (*this) == UNSPECIFIED;
+        return this->value == 0;
     }
 
     bool isBroadcast() const {
-        return (*this) == IEEE802154MacAddress(SHORT_BROADCAST_ADDRESS);
+        return this->value == (SHORT_ADDRESS_PREFIX | SHORT_BROADCAST_ADDRESS);
+    }
+
+    /**
+     * @return true if this address was derived from a short address, e.g. by IEEE802154MacAddress(uint16_t)
+     */
+    bool isShortAddress() const {
+        return (this->value & ~WORD_MASK) == SHORT_ADDRESS_PREFIX;
     }
 
     // TODO should be determined via association
     void setShortAddress(uint16_t shortAddr) {
-        (*this) = IEEE802154MacAddress(shortAddr);
+        this->value = SHORT_ADDRESS_PREFIX | shortAddr;
     }
 
     // TODO should be determined via association
     uint16_t getShortAddress() const {
-        return addr[3];
+        return a4();
     }
 
     uint64_t getExtendedAdress() const = delete;
 
+    /**
+     * @return All four words packed as (a1 << 48) | (a2 << 32) | (a3 << 16) | a4, suited as key for ordering and hashing
+     */
+    uint64_t getPacked() const {
+        return this->value;
+    }
+
     friend Serializer& operator<<(Serializer& serializer, IEEE802154MacAddress& addr);
 
     friend uint8_t* operator<<(uint8_t*& buffer, const IEEE802154MacAddress& addr);
     friend const uint8_t* operator>>(const uint8_t*& buffer, IEEE802154MacAddress& addr);
 
 private:
-    uint16_t addr[4];
+    static constexpr uint64_t WORD_MASK{0xffff};
+
+    /* a1 .. a3 of the addresses derived from short addresses */
+    static constexpr uint64_t SHORT_ADDRESS_PREFIX{0x000000fffe000000};
+
+    static constexpr uint64_t pack(uint16_t a1, uint16_t a2, uint16_t a3, uint16_t a4) {
+        return ((uint64_t)a1 << 48) | ((uint64_t)a2 << 32) | ((uint64_t)a3 << 16) | a4;
+    }
+
+    uint64_t value;
 };
 
 inline Serializer& operator<<(Serializer& serializer, IEEE802154MacAddress& addr) {
-    serializer << addr.addr[0];
-    serializer << addr.addr[1];
-    serializer << addr.addr[2];
-    serializer << addr.addr[3];
+    /* the serializer both writes and reads through the references */
+    uint16_t a[4] = {addr.a1(), addr.a2(), addr.a3(), addr.a4()};
+    serializer << a[0];
+    serializer << a[1];
+    serializer << a[2];
+    serializer << a[3];
+    addr.value = IEEE802154MacAddress::pack(a[0], a[1], a[2], a[3]);
     return serializer;
 }
 
 /* NEW FAST SERIALISATION **************************************************************/
 
+/* the words are transmitted a4 first, each in little endian, which is the little endian byte order of the packed value */
 inline uint8_t* operator<<(uint8_t*& buffer, const IEEE802154MacAddress& addr) {
-    *(buffer++) = addr.addr[3] & 0xFF;
-    *(buffer++) = addr.addr[3] >> 8;
-    *(buffer++) = addr.addr[2] & 0xFF;
-    *(buffer++) = addr.addr[2] >> 8;
-    *(buffer++) = addr.addr[1] & 0xFF;
-    *(buffer++) = addr.addr[1] >> 8;
-    *(buffer++) = addr.addr[0] & 0xFF;
-    *(buffer++) = addr.addr[0] >> 8;
+    for(uint8_t i = 0; i < 8; i++) {
+        *(buffer++) = addr.value >> (8 * i);
+    }
 
     return buffer;
 }
 
 inline const uint8_t* operator>>(const uint8_t*& buffer, IEEE802154MacAddress& addr) {
-    addr.addr[3] = *(buffer) | (*(buffer + 1) << 8);
-    buffer += 2;
-
-    addr.addr[2] = *(buffer) | (*(buffer + 1) << 8);
-    buffer += 2;
-
-    addr.addr[1] = *(buffer) | (*(buffer + 1) << 8);
-    buffer += 2;
-
-    addr.addr[0] = *(buffer) | (*(buffer + 1) << 8);
-    buffer += 2;
+    addr.value = 0;
+    for(uint8_t i = 0; i < 8; i++) {
+        addr.value |= (uint64_t)*(buffer++) << (8 * i);
+    }
 
     return buffer;
 }
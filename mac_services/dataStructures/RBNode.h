@@ -43,6 +43,7 @@
 #ifndef RBNODE_H_
 #define RBNODE_H_
 
+#include "../../helper/Integers.h"
 #include "./RBTree.h"
 #include "./RBTreeIterator.h"
 
@@ -52,16 +53,15 @@ namespace dsme {
 enum color_t { RED, BLACK };
 
 /* CLASSES *******************************************************************/
-template <typename T, typename K>
+template <typename T, typename K, uint16_t N>
 class RBTree;
 
-template <typename T, typename K>
+template <typename T, typename K, uint16_t N>
 class RBTreeIterator;
 
 template <typename T, typename K>
 struct RBNode {
     RBNode(const T& content, const K& key);
-    virtual ~RBNode() = default;
 
     /*
      * Get the object stored in the node
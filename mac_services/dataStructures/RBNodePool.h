@@ -0,0 +1,130 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef RBNODEPOOL_H_
+#define RBNODEPOOL_H_
+
+#include <new>
+#include "../../helper/Integers.h"
+#include "./RBNode.h"
+
+namespace dsme {
+
+/* CLASSES *******************************************************************/
+
+/*
+ * fixed-capacity storage for the nodes of an RBTree
+ * unused slots are chained into an intrusive free list, so allocate() and release() take O(1)
+ * and never touch the heap
+ */
+template <typename T, typename K, uint16_t N>
+class RBNodePool {
+public:
+    RBNodePool();
+
+    /*
+     * Nodes still allocated are not destroyed, this is up to the owning tree.
+     */
+    ~RBNodePool() = default;
+
+    RBNodePool(const RBNodePool&) = delete;
+    RBNodePool& operator=(const RBNodePool&) = delete;
+
+    /*
+     * Constructs a node in a free slot
+     * @return the new node, nullptr if all N slots are in use
+     */
+    RBNode<T, K>* allocate(const T& content, const K& key);
+
+    /*
+     * Destroys a node previously returned by allocate() and puts its slot back into the free list
+     */
+    void release(RBNode<T, K>* node);
+
+private:
+    union Slot {
+        Slot() {
+        }
+        ~Slot() {
+        }
+
+        RBNode<T, K> node;
+        Slot* nextFree;
+    };
+
+    Slot slots[N];
+    Slot* freeList;
+};
+
+/* FUNCTION DEFINITIONS ******************************************************/
+
+template <typename T, typename K, uint16_t N>
+RBNodePool<T, K, N>::RBNodePool() : freeList(&slots[0]) {
+    for(uint16_t i = 0; i < N - 1; i++) {
+        slots[i].nextFree = &slots[i + 1];
+    }
+    slots[N - 1].nextFree = nullptr;
+}
+
+template <typename T, typename K, uint16_t N>
+RBNode<T, K>* RBNodePool<T, K, N>::allocate(const T& content, const K& key) {
+    if(freeList == nullptr) {
+        return nullptr;
+    }
+
+    Slot* slot = freeList;
+    freeList = slot->nextFree;
+    return new(&slot->node) RBNode<T, K>(content, key);
+}
+
+template <typename T, typename K, uint16_t N>
+void RBNodePool<T, K, N>::release(RBNode<T, K>* node) {
+    node->~RBNode<T, K>();
+
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    slot->nextFree = freeList;
+    freeList = slot;
+}
+
+} /* namespace dsme */
+
+#endif /* RBNODEPOOL_H_ */
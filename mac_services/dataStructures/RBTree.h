@@ -45,6 +45,7 @@
 
 #include "../../helper/Integers.h"
 #include "./RBNode.h"
+#include "./RBNodePool.h"
 #include "./RBTreeIterator.h"
 
 namespace dsme {
@@ -57,11 +58,12 @@ struct RBNode;
 /*
  * generic implementation of an RB-Tree
  * advantage: balanced binary search tree -> find() in maximal O(log n) steps
+ * the nodes are taken from a pool of N nodes inside the tree, so it never uses the heap
  */
-template <typename T, typename K>
+template <typename T, typename K, uint16_t N>
 class RBTree {
 public:
-    typedef RBTreeIterator<T, K> iterator;
+    typedef RBTreeIterator<T, K, N> iterator;
     typedef uint16_t tree_size_t;
 
     /*
@@ -84,7 +86,7 @@ public:
      * Stores new object at correct position
      * @Param obj: object to be inserted
      *        key: key to identify the object
-     * @return true, if insert was successful
+     * @return true, if insert was successful, false for a duplicate key or if the tree already holds N objects
      */
     bool insert(T obj, K key);
 
@@ -129,6 +131,11 @@ private:
      */
     tree_size_t m_size;
 
+    /*
+     * storage for all nodes
+     */
+    RBNodePool<T, K, N> pool;
+
     /*
      * rotate tree to the right, if not balanced
      * @Param node x is center of the rotation
@@ -174,47 +181,47 @@ private:
 
 /* FUNCTION DEFINITIONS ******************************************************/
 
-template <typename T, typename K>
-RBTree<T, K>::RBTree() : root(nullptr), m_size(0) {
+template <typename T, typename K, uint16_t N>
+RBTree<T, K, N>::RBTree() : root(nullptr), m_size(0) {
 }
 
-template <typename T, typename K>
-RBTree<T, K>::~RBTree() {
+template <typename T, typename K, uint16_t N>
+RBTree<T, K, N>::~RBTree() {
     iterator iter = this->begin();
     while(iter != this->end()) {
-        delete(iter++).currentNode;
+        pool.release((iter++).currentNode);
     }
 }
 
-template <typename T, typename K>
-RBNode<T, K>* RBTree<T, K>::getRoot() {
+template <typename T, typename K, uint16_t N>
+RBNode<T, K>* RBTree<T, K, N>::getRoot() {
     return root;
 }
 
-template <typename T, typename K>
-typename RBTree<T, K>::iterator RBTree<T, K>::begin() {
-    return RBTree<T, K>::iterator::begin(this, root);
+template <typename T, typename K, uint16_t N>
+typename RBTree<T, K, N>::iterator RBTree<T, K, N>::begin() {
+    return RBTree<T, K, N>::iterator::begin(this, root);
 }
 
-template <typename T, typename K>
-typename RBTree<T, K>::iterator RBTree<T, K>::end() {
-    return RBTree<T, K>::iterator(this, nullptr);
+template <typename T, typename K, uint16_t N>
+typename RBTree<T, K, N>::iterator RBTree<T, K, N>::end() {
+    return RBTree<T, K, N>::iterator(this, nullptr);
 }
 
-template <typename T, typename K>
-const typename RBTree<T, K>::iterator RBTree<T, K>::end() const {
-    return RBTree<T, K>::iterator(this, nullptr);
+template <typename T, typename K, uint16_t N>
+const typename RBTree<T, K, N>::iterator RBTree<T, K, N>::end() const {
+    return RBTree<T, K, N>::iterator(this, nullptr);
 }
 
-template <typename T, typename K>
-bool RBTree<T, K>::insert(T obj, K key) {
+template <typename T, typename K, uint16_t N>
+bool RBTree<T, K, N>::insert(T obj, K key) {
     RBNode<T, K>* node;
-    if(m_size == (tree_size_t)-1) {
-        /* '-> tree is already full, depends on bit-width of 'tree_size_t' */
+    if(m_size == N) {
+        /* '-> tree is already full, all nodes of the pool are in use */
         return false;
     }
     if(m_size == 0) {
-        node = new RBNode<T, K>(obj, key);
+        node = pool.allocate(obj, key);
         /* '-> tree was empty -> inserted object becomes root */
         node->parent = nullptr;
         node->color = BLACK; // Transformation_1: tree was empty before
@@ -230,7 +237,7 @@ bool RBTree<T, K>::insert(T obj, K key) {
                 /* '-> key is smaller -> left path */
                 if(current->leftChild == nullptr) {
                     /* '-> has no left-side child -> current node sets his child -> position found */
-                    node = new RBNode<T, K>(obj, key);
+                    node = pool.allocate(obj, key);
                     node->parent = current;
                     current->leftChild = node;
                     break;
@@ -240,7 +247,7 @@ bool RBTree<T, K>::insert(T obj, K key) {
                 /* '-> key is larger -> right path */
                 if(current->rightChild == nullptr) {
                     /* '-> has no right-side child -> current node sets his child -> position found */
-                    node = new RBNode<T, K>(obj, key);
+                    node = pool.allocate(obj, key);
                     node->parent = current;
                     current->rightChild = node;
                     break;
@@ -315,8 +322,8 @@ bool RBTree<T, K>::insert(T obj, K key) {
     return true;
 }
 
-template <typename T, typename K>
-void RBTree<T, K>::balanceTree(RBNode<T, K>* node) {
+template <typename T, typename K, uint16_t N>
+void RBTree<T, K, N>::balanceTree(RBNode<T, K>* node) {
     /*
      * node : in first iteration -> deleted node (is black and has no children)
      *        other -> problem node
@@ -421,8 +428,8 @@ void RBTree<T, K>::balanceTree(RBNode<T, K>* node) {
     }
 }
 
-template <typename T, typename K>
-void RBTree<T, K>::remove(iterator& iter) {
+template <typename T, typename K, uint16_t N>
+void RBTree<T, K, N>::remove(iterator& iter) {
     if(iter == end()) {
         return;
     }
@@ -460,7 +467,7 @@ void RBTree<T, K>::remove(iterator& iter) {
         if(child != nullptr) {
             child->parent = nullptr;
         }
-        delete rnode;
+        pool.release(rnode);
 
     }
     /*
@@ -477,7 +484,7 @@ void RBTree<T, K>::remove(iterator& iter) {
             parent->rightChild = child;
         }
 
-        delete rnode;
+        pool.release(rnode);
 
     } else if(child == nullptr && rnode->color == BLACK && parent != nullptr) {
         /*
@@ -490,7 +497,7 @@ void RBTree<T, K>::remove(iterator& iter) {
             parent->rightChild = nullptr;
         }
 
-        delete rnode;
+        pool.release(rnode);
     } else if(child->color == RED && parent != nullptr && rnode->color == BLACK) {
         /*
          * case 5.2.1: rnode is BLACK and child is RED
@@ -502,7 +509,7 @@ void RBTree<T, K>::remove(iterator& iter) {
             parent->rightChild = child;
         }
         child->parent = parent;
-        delete rnode;
+        pool.release(rnode);
     } else {
         /*
          * case 5.2.2: rnode is BLACK and child is BLACK -> should not be possible to exist
@@ -513,13 +520,13 @@ void RBTree<T, K>::remove(iterator& iter) {
     m_size--;
 }
 
-template <typename T, typename K>
-typename RBTree<T, K>::iterator RBTree<T, K>::find(K key) {
+template <typename T, typename K, uint16_t N>
+typename RBTree<T, K, N>::iterator RBTree<T, K, N>::find(K key) {
     RBNode<T, K>* current = root;
 
     while(current != nullptr) {
         if(current->key == key) {
-            return RBTree<T, K>::iterator(this, current);
+            return RBTree<T, K, N>::iterator(this, current);
         } else if(key < current->key) {
             current = current->leftChild;
         } else {
@@ -529,16 +536,16 @@ typename RBTree<T, K>::iterator RBTree<T, K>::find(K key) {
     return end();
 }
 
-template <typename T, typename K>
-RBNode<T, K>* RBTree<T, K>::grandparent(RBNode<T, K>* x) {
+template <typename T, typename K, uint16_t N>
+RBNode<T, K>* RBTree<T, K, N>::grandparent(RBNode<T, K>* x) {
     if(x == nullptr || x->parent == nullptr) {
         return nullptr;
     }
     return x->parent->parent;
 }
 
-template <typename T, typename K>
-RBNode<T, K>* RBTree<T, K>::uncle(RBNode<T, K>* x) {
+template <typename T, typename K, uint16_t N>
+RBNode<T, K>* RBTree<T, K, N>::uncle(RBNode<T, K>* x) {
     if(grandparent(x) == nullptr) {
         return nullptr;
     }
@@ -549,8 +556,8 @@ RBNode<T, K>* RBTree<T, K>::uncle(RBNode<T, K>* x) {
     }
 }
 
-template <typename T, typename K>
-RBNode<T, K>* RBTree<T, K>::sibling(RBNode<T, K>* x) {
+template <typename T, typename K, uint16_t N>
+RBNode<T, K>* RBTree<T, K, N>::sibling(RBNode<T, K>* x) {
     if(x->parent == nullptr) {
         return nullptr;
     }
@@ -561,8 +568,8 @@ RBNode<T, K>* RBTree<T, K>::sibling(RBNode<T, K>* x) {
     }
 }
 
-template <typename T, typename K>
-RBNode<T, K>* RBTree<T, K>::findSwapNode(RBNode<T, K>* x) {
+template <typename T, typename K, uint16_t N>
+RBNode<T, K>* RBTree<T, K, N>::findSwapNode(RBNode<T, K>* x) {
     /*
      * find node with smallest key in right subtree of x
      */
@@ -574,13 +581,13 @@ RBNode<T, K>* RBTree<T, K>::findSwapNode(RBNode<T, K>* x) {
     return node;
 }
 
-template <typename T, typename K>
-typename RBTree<T, K>::tree_size_t RBTree<T, K>::size() const {
+template <typename T, typename K, uint16_t N>
+typename RBTree<T, K, N>::tree_size_t RBTree<T, K, N>::size() const {
     return m_size;
 }
 
-template <typename T, typename K>
-void RBTree<T, K>::rotate_right(RBNode<T, K>* x) {
+template <typename T, typename K, uint16_t N>
+void RBTree<T, K, N>::rotate_right(RBNode<T, K>* x) {
     RBNode<T, K> *leftchild, *rightgrandchild, *parent;
 
     leftchild = x->leftChild;
@@ -609,8 +616,8 @@ void RBTree<T, K>::rotate_right(RBNode<T, K>* x) {
     }
 }
 
-template <typename T, typename K>
-void RBTree<T, K>::rotate_left(RBNode<T, K>* x) {
+template <typename T, typename K, uint16_t N>
+void RBTree<T, K, N>::rotate_left(RBNode<T, K>* x) {
     RBNode<T, K> *rightchild, *leftgrandchild, *parent;
     rightchild = x->rightChild;
     leftgrandchild = rightchild->leftChild;
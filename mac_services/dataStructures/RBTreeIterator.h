@@ -50,18 +50,21 @@
 
 namespace dsme {
 
-template <typename T, typename K>
+template <typename T, typename K, uint16_t N>
 class RBTree;
 
 template <typename T, typename K>
 struct RBNode;
 
-template <typename T, typename K>
+template <typename T, typename K, uint16_t N>
 class RBTreeIterator {
-    friend class RBTree<T, K>;
+    friend class RBTree<T, K, N>;
 
 public:
-    RBTreeIterator(const RBTree<T, K>* instance, RBNode<T, K>* initialNode);
+    /* an iterator that does not belong to any tree, it has to be assigned before use */
+    RBTreeIterator();
+
+    RBTreeIterator(const RBTree<T, K, N>* instance, RBNode<T, K>* initialNode);
 
     RBTreeIterator(const RBTreeIterator&);
 
@@ -69,50 +72,54 @@ public:
 
     ~RBTreeIterator() = default;
 
-    RBTreeIterator<T, K>& operator=(const RBTreeIterator<T, K>&);
-    RBTreeIterator<T, K>& operator=(RBTreeIterator<T, K>&&);
+    RBTreeIterator<T, K, N>& operator=(const RBTreeIterator<T, K, N>&);
+    RBTreeIterator<T, K, N>& operator=(RBTreeIterator<T, K, N>&&);
 
-    RBTreeIterator<T, K>& operator++();
-    RBTreeIterator<T, K> operator++(int);
+    RBTreeIterator<T, K, N>& operator++();
+    RBTreeIterator<T, K, N> operator++(int);
 
     T& operator*();
     T* operator->();
     const T* operator->() const;
     RBNode<T, K>* node();
 
-    bool operator==(const RBTreeIterator<T, K>&) const;
-    bool operator!=(const RBTreeIterator<T, K>&) const;
+    bool operator==(const RBTreeIterator<T, K, N>&) const;
+    bool operator!=(const RBTreeIterator<T, K, N>&) const;
 
-    static RBTreeIterator<T, K> begin(RBTree<T, K>* instance, RBNode<T, K>* rootNode);
+    static RBTreeIterator<T, K, N> begin(RBTree<T, K, N>* instance, RBNode<T, K>* rootNode);
 
 private:
-    const RBTree<T, K>* instance;
+    const RBTree<T, K, N>* instance;
     RBNode<T, K>* currentNode;
 };
 
-template <typename T, typename K>
-RBTreeIterator<T, K>::RBTreeIterator(const RBTree<T, K>* instance, RBNode<T, K>* initialNode) : instance(instance), currentNode(initialNode) {
+template <typename T, typename K, uint16_t N>
+RBTreeIterator<T, K, N>::RBTreeIterator() : instance(nullptr), currentNode(nullptr) {
 }
 
-template <typename T, typename K>
-RBTreeIterator<T, K>::RBTreeIterator(const RBTreeIterator& other) : instance(other.instance), currentNode(other.currentNode) {
+template <typename T, typename K, uint16_t N>
+RBTreeIterator<T, K, N>::RBTreeIterator(const RBTree<T, K, N>* instance, RBNode<T, K>* initialNode) : instance(instance), currentNode(initialNode) {
 }
 
-template <typename T, typename K>
-RBTreeIterator<T, K>::RBTreeIterator(RBTreeIterator&& other) : instance(other.instance), currentNode(other.currentNode) {
+template <typename T, typename K, uint16_t N>
+RBTreeIterator<T, K, N>::RBTreeIterator(const RBTreeIterator& other) : instance(other.instance), currentNode(other.currentNode) {
+}
+
+template <typename T, typename K, uint16_t N>
+RBTreeIterator<T, K, N>::RBTreeIterator(RBTreeIterator&& other) : instance(other.instance), currentNode(other.currentNode) {
     other.instance = nullptr;
     other.currentNode = nullptr;
 }
 
-template <typename T, typename K>
-RBTreeIterator<T, K>& RBTreeIterator<T, K>::operator=(const RBTreeIterator<T, K>& other) {
+template <typename T, typename K, uint16_t N>
+RBTreeIterator<T, K, N>& RBTreeIterator<T, K, N>::operator=(const RBTreeIterator<T, K, N>& other) {
     this->instance = other.instance;
     this->currentNode = other.currentNode;
     return *this;
 }
 
-template <typename T, typename K>
-RBTreeIterator<T, K>& RBTreeIterator<T, K>::operator=(RBTreeIterator<T, K>&& other) {
+template <typename T, typename K, uint16_t N>
+RBTreeIterator<T, K, N>& RBTreeIterator<T, K, N>::operator=(RBTreeIterator<T, K, N>&& other) {
     this->instance = other.instance;
     this->currentNode = other.currentNode;
 
@@ -125,8 +132,8 @@ RBTreeIterator<T, K>& RBTreeIterator<T, K>::operator=(RBTreeIterator<T, K>&& oth
 /**
  * iterate over Tree in postorder
  */
-template <typename T, typename K>
-RBTreeIterator<T, K>& RBTreeIterator<T, K>::operator++() {
+template <typename T, typename K, uint16_t N>
+RBTreeIterator<T, K, N>& RBTreeIterator<T, K, N>::operator++() {
     RBNode<T, K>* parent;
 
     if(this->currentNode == nullptr) {
@@ -167,8 +174,8 @@ RBTreeIterator<T, K>& RBTreeIterator<T, K>::operator++() {
 
 #else
 
-template <typename T, typename K>
-RBTreeIterator<T, K>& RBTreeIterator<T, K>::operator++() {
+template <typename T, typename K, uint16_t N>
+RBTreeIterator<T, K, N>& RBTreeIterator<T, K, N>::operator++() {
     if(this->currentNode == nullptr) {
         return *this;
     }
@@ -199,46 +206,46 @@ RBTreeIterator<T, K>& RBTreeIterator<T, K>::operator++() {
 
 #endif
 
-template <typename T, typename K>
-RBTreeIterator<T, K> RBTreeIterator<T, K>::operator++(int) {
-    RBTreeIterator<T, K> old = *this;
+template <typename T, typename K, uint16_t N>
+RBTreeIterator<T, K, N> RBTreeIterator<T, K, N>::operator++(int) {
+    RBTreeIterator<T, K, N> old = *this;
     ++(*this);
     return old;
 }
 
-template <typename T, typename K>
-T& RBTreeIterator<T, K>::operator*() {
+template <typename T, typename K, uint16_t N>
+T& RBTreeIterator<T, K, N>::operator*() {
     return this->currentNode->getContent();
 }
 
-template <typename T, typename K>
-T* RBTreeIterator<T, K>::operator->() {
+template <typename T, typename K, uint16_t N>
+T* RBTreeIterator<T, K, N>::operator->() {
     return &(this->currentNode->getContent());
 }
 
-template <typename T, typename K>
-const T* RBTreeIterator<T, K>::operator->() const {
+template <typename T, typename K, uint16_t N>
+const T* RBTreeIterator<T, K, N>::operator->() const {
     return &(this->currentNode->getContent());
 }
 
-template <typename T, typename K>
-RBNode<T, K>* RBTreeIterator<T, K>::node() {
+template <typename T, typename K, uint16_t N>
+RBNode<T, K>* RBTreeIterator<T, K, N>::node() {
     return this->currentNode;
 }
 
-template <typename T, typename K>
-bool RBTreeIterator<T, K>::operator==(const RBTreeIterator<T, K>& other) const {
+template <typename T, typename K, uint16_t N>
+bool RBTreeIterator<T, K, N>::operator==(const RBTreeIterator<T, K, N>& other) const {
     return (this->instance == other.instance && this->currentNode == other.currentNode);
 }
 
-template <typename T, typename K>
-bool RBTreeIterator<T, K>::operator!=(const RBTreeIterator<T, K>& other) const {
+template <typename T, typename K, uint16_t N>
+bool RBTreeIterator<T, K, N>::operator!=(const RBTreeIterator<T, K, N>& other) const {
     return !((*this) == other);
 }
 
 #ifdef RBTREE_ITERATOR_POSTORDER
-template <typename T, typename K>
-RBTreeIterator<T, K> RBTreeIterator<T, K>::begin(RBTree<T, K>* instance, RBNode<T, K>* rootNode) {
+template <typename T, typename K, uint16_t N>
+RBTreeIterator<T, K, N> RBTreeIterator<T, K, N>::begin(RBTree<T, K, N>* instance, RBNode<T, K>* rootNode) {
     if(rootNode == nullptr) {
         return RBTreeIterator(instance, rootNode);
     }
@@ -257,8 +264,8 @@ RBTreeIterator<T, K> RBTreeIterator<T, K>::begin(RBTree<T, K>* instance, RBNode<
     }
 }
 #else
-template <typename T, typename K>
-RBTreeIterator<T, K> RBTreeIterator<T, K>::begin(RBTree<T, K>* instance, RBNode<T, K>* rootNode) {
+template <typename T, typename K, uint16_t N>
+RBTreeIterator<T, K, N> RBTreeIterator<T, K, N>::begin(RBTree<T, K, N>* instance, RBNode<T, K>* rootNode) {
     return RBTreeIterator(instance, rootNode);
 }
 #endif
@@ -106,7 +106,7 @@ void DATA::request(request_parameters& params) {
             return;
         }
 
-        if(!this->dsme.getMessageDispatcher().sendInGTS(msg, destIt)) {
+        if(!this->dsme.getMessageDispatcher().sendInGTS(msg, destIt, params.priority)) {
             mcps_sap::DATA_confirm_parameters confirmParams;
             confirmParams.msduHandle = msg;
             confirmParams.timestamp = 0;
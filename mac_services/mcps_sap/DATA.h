@@ -153,6 +153,7 @@ public:
         bool sendMultipurpose;
         NOT_IMPLEMENTED_t frakPolicy;
         NOT_IMPLEMENTED_t criticalEventMessage;
+        uint8_t priority = 0; // not in IEEE 802.15.4, priority class in the GTS queue, 0 is the least urgent
     };
 
     void request(request_parameters&);
@@ -0,0 +1,100 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "./EventQueue.h"
+
+#include <algorithm>
+#include <iostream>
+#include "../../dsme_platform.h"
+
+namespace dsme {
+namespace sim {
+
+/* The queue that is currently executed by this thread, used for the log prefix */
+static thread_local const EventQueue* activeQueue = nullptr;
+
+void printLogPrefix(std::ostream& stream) {
+    if(activeQueue == nullptr) {
+        return;
+    }
+    stream << "[" << activeQueue->now() << "]";
+    if(activeQueue->getCurrentNode() != NO_NODE) {
+        stream << "[" << activeQueue->getCurrentNode() << "]";
+    }
+    stream << " ";
+}
+
+node_id_t currentNodeId() {
+    return (activeQueue != nullptr) ? activeQueue->getCurrentNode() : NO_NODE;
+}
+
+EventQueue::EventQueue() : currentTime(0), currentNode(NO_NODE), nextSequence(0), numProcessedEvents(0) {
+}
+
+void EventQueue::schedule(sim_time_t time, node_id_t node, handler_t handler) {
+    DSME_ASSERT(time >= currentTime);
+    heap.push_back(Event{time, nextSequence++, node, std::move(handler)});
+    std::push_heap(heap.begin(), heap.end(), Later());
+}
+
+void EventQueue::runUntil(sim_time_t endTime) {
+    const EventQueue* previousQueue = activeQueue;
+    activeQueue = this;
+
+    while(!heap.empty() && heap.front().time <= endTime) {
+        std::pop_heap(heap.begin(), heap.end(), Later());
+        Event event = std::move(heap.back());
+        heap.pop_back();
+
+        currentTime = event.time;
+        currentNode = event.node;
+        event.handler();
+        numProcessedEvents++;
+    }
+
+    currentTime = endTime;
+    currentNode = NO_NODE;
+    activeQueue = previousQueue;
+}
+
+} /* namespace sim */
+} /* namespace dsme */
@@ -0,0 +1,106 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef EVENTQUEUE_H_
+#define EVENTQUEUE_H_
+
+#include <functional>
+#include <vector>
+#include "./SimTypes.h"
+
+namespace dsme {
+namespace sim {
+
+/**
+ * Virtual clock of the simulation. Events are executed strictly ordered by their time and,
+ * for equal times, by the order they were scheduled in, so every run is reproducible.
+ */
+class EventQueue {
+public:
+    typedef std::function<void()> handler_t;
+
+    EventQueue();
+
+    sim_time_t now() const {
+        return currentTime;
+    }
+
+    /** Node whose event is currently executed, NO_NODE for global events. */
+    node_id_t getCurrentNode() const {
+        return currentNode;
+    }
+
+    /** Schedules \p handler at the absolute time \p time on behalf of node \p node. */
+    void schedule(sim_time_t time, node_id_t node, handler_t handler);
+
+    /** Executes all events up to and including \p endTime and advances the clock to \p endTime. */
+    void runUntil(sim_time_t endTime);
+
+    uint64_t getNumProcessedEvents() const {
+        return numProcessedEvents;
+    }
+
+private:
+    struct Event {
+        sim_time_t time;
+        uint64_t sequence;
+        node_id_t node;
+        handler_t handler;
+    };
+
+    struct Later {
+        bool operator()(const Event& a, const Event& b) const {
+            return (a.time > b.time) || (a.time == b.time && a.sequence > b.sequence);
+        }
+    };
+
+    std::vector<Event> heap;
+    sim_time_t currentTime;
+    node_id_t currentNode;
+    uint64_t nextSequence;
+    uint64_t numProcessedEvents;
+};
+
+} /* namespace sim */
+} /* namespace dsme */
+
+#endif /* EVENTQUEUE_H_ */
@@ -0,0 +1,139 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "./SimMedium.h"
+
+#include "../../dsme_platform.h"
+#include "./EventQueue.h"
+#include "./SimPlatform.h"
+
+namespace dsme {
+namespace sim {
+
+SimMedium::SimMedium(EventQueue& queue, uint32_t seed) : queue(queue), packetErrorRate(0), randomState(seed | 1) {
+}
+
+void SimMedium::attach(SimPlatform* node) {
+    DSME_ASSERT(node->getId() == nodes.size());
+    nodes.push_back(node);
+}
+
+void SimMedium::transmit(SimPlatform& sender, uint8_t channel, SimMessage& frame) {
+    statistics.numTransmissions++;
+
+    transmissions.emplace_back();
+    auto transmission = std::prev(transmissions.end());
+    transmission->sender = sender.getId();
+    transmission->channel = channel;
+    transmission->start = queue.now();
+    transmission->collided = false;
+    transmission->frame.copyFrom(frame);
+
+    for(auto other = transmissions.begin(); other != transmission; ++other) {
+        if(other->channel == channel) {
+            other->collided = true;
+            transmission->collided = true;
+        }
+    }
+
+    /* a receiver has to be listening on the channel when the preamble starts */
+    for(SimPlatform* node : nodes) {
+        if(node->getId() == sender.getId()) {
+            continue;
+        }
+        if(node->isListening(channel)) {
+            transmission->receivers.push_back(node->getId());
+        } else {
+            statistics.numNotListening++;
+        }
+    }
+
+    sim_time_t end = queue.now() + frame.getTotalSymbols();
+    queue.schedule(end, sender.getId(), [this, transmission]() { finishTransmission(transmission); });
+}
+
+bool SimMedium::isChannelBusy(uint8_t channel) const {
+    for(const Transmission& transmission : transmissions) {
+        if(transmission.channel == channel) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SimMedium::finishTransmission(std::list<Transmission>::iterator transmission) {
+    if(transmission->collided) {
+        statistics.numCollisions++;
+    }
+
+    for(node_id_t id : transmission->receivers) {
+        SimPlatform* receiver = nodes[id];
+        if(transmission->collided) {
+            continue;
+        }
+        if(!receiver->isListening(transmission->channel) || receiver->getLastTransmissionStart() >= transmission->start) {
+            /* '-> switched the channel, turned off or transmitted in between */
+            statistics.numNotListening++;
+            continue;
+        }
+        if(packetErrorRate > 0 && nextRandom() % 1000 < packetErrorRate) {
+            statistics.numLostFrames++;
+            continue;
+        }
+        receiver->handleFrameReception(transmission->frame, transmission->start);
+    }
+
+    SimPlatform* sender = nodes[transmission->sender];
+    transmissions.erase(transmission);
+    sender->handleTransmissionEnd();
+}
+
+uint16_t SimMedium::nextRandom() {
+    /* xorshift32 */
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState >> 16;
+}
+
+} /* namespace sim */
+} /* namespace dsme */
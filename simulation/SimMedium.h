@@ -0,0 +1,113 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef SIMMEDIUM_H_
+#define SIMMEDIUM_H_
+
+#include <list>
+#include <vector>
+#include "./SimMessage.h"
+#include "./SimTypes.h"
+
+namespace dsme {
+namespace sim {
+
+class EventQueue;
+class SimPlatform;
+
+struct MediumStatistics {
+    uint64_t numTransmissions{0};
+    uint64_t numCollisions{0};     /* frames destroyed by an overlapping frame on the same channel */
+    uint64_t numLostFrames{0};     /* frame copies dropped by the packet error rate */
+    uint64_t numNotListening{0};   /* frame copies not received since the receiver was off, busy or tuned to another channel */
+};
+
+/**
+ * Shared wireless medium of one PAN. All attached nodes are within range of each other,
+ * so overlapping transmissions on the same channel destroy each other for every receiver.
+ * Loss beyond collisions is modeled by a uniform, seeded packet error rate.
+ */
+class SimMedium {
+public:
+    SimMedium(EventQueue& queue, uint32_t seed);
+
+    void attach(SimPlatform* node);
+
+    void setPacketErrorRate(uint16_t perMille) {
+        packetErrorRate = perMille;
+    }
+
+    /** Puts a copy of \p frame on the air, the sender is informed via SimPlatform::handleTransmissionEnd. */
+    void transmit(SimPlatform& sender, uint8_t channel, SimMessage& frame);
+
+    /** Result of a clear channel assessment on \p channel at the current time. */
+    bool isChannelBusy(uint8_t channel) const;
+
+    const MediumStatistics& getStatistics() const {
+        return statistics;
+    }
+
+private:
+    struct Transmission {
+        node_id_t sender;
+        uint8_t channel;
+        sim_time_t start;
+        bool collided;
+        SimMessage frame;
+        std::vector<node_id_t> receivers;
+    };
+
+    void finishTransmission(std::list<Transmission>::iterator transmission);
+    uint16_t nextRandom();
+
+    EventQueue& queue;
+    std::vector<SimPlatform*> nodes;
+    std::list<Transmission> transmissions;
+    MediumStatistics statistics;
+    uint16_t packetErrorRate;
+    uint32_t randomState;
+};
+
+} /* namespace sim */
+} /* namespace dsme */
+
+#endif /* SIMMEDIUM_H_ */
@@ -0,0 +1,122 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "./SimMessage.h"
+
+#include <cstring>
+#include "../../dsme_platform.h"
+#include "../mac_services/dataStructures/DSMEMessageElement.h"
+
+namespace dsme {
+namespace sim {
+
+SimMessage::SimMessage() {
+    clear();
+}
+
+void SimMessage::clear() {
+    header.reset();
+    payloadLength = 0;
+    startOfFrameDelimiterSymbolCounter = 0;
+    receptionEndTime = 0;
+    lqi = 255;
+    receivedViaMCPS = false;
+    currentlySending = false;
+    retryCounter = 0;
+    queueAtCreation = -1;
+}
+
+void SimMessage::copyFrom(const SimMessage& other) {
+    header = other.header;
+    memcpy(payload, other.payload, other.payloadLength);
+    payloadLength = other.payloadLength;
+    startOfFrameDelimiterSymbolCounter = other.startOfFrameDelimiterSymbolCounter;
+    receptionEndTime = other.receptionEndTime;
+    lqi = other.lqi;
+}
+
+bool SimMessage::appendPayload(uint8_t length) {
+    if(payloadLength + length > MAX_PAYLOAD_LENGTH) {
+        return false;
+    }
+    for(uint8_t i = 0; i < length; i++) {
+        payload[payloadLength + i] = i;
+    }
+    payloadLength += length;
+    return true;
+}
+
+void SimMessage::prependFrom(DSMEMessageElement* msg) {
+    uint8_t length = msg->getSerializationLength();
+    DSME_ASSERT(payloadLength + length <= MAX_PAYLOAD_LENGTH);
+
+    memmove(payload + length, payload, payloadLength);
+    payloadLength += length;
+
+    Serializer serializer(payload, SERIALIZATION);
+    msg->serialize(serializer);
+    DSME_ASSERT(serializer.getData() == payload + length);
+}
+
+void SimMessage::decapsulateTo(DSMEMessageElement* msg) {
+    Serializer serializer(payload, DESERIALIZATION);
+    msg->serialize(serializer);
+
+    uint8_t length = serializer.getData() - payload;
+    DSME_ASSERT(length <= payloadLength);
+
+    payloadLength -= length;
+    memmove(payload, payload + length, payloadLength);
+}
+
+uint16_t SimMessage::getTotalSymbols() {
+    /* preamble (4) + SFD (1) + PHY header (1) + MPDU, 2 symbols per octet */
+    return 2 * 6 + getMPDUSymbols();
+}
+
+uint8_t SimMessage::getMPDUSymbols() {
+    /* MAC header + payload + FCS (2), 2 symbols per octet */
+    return 2 * (header.getSerializationLength() + payloadLength + 2);
+}
+
+} /* namespace sim */
+} /* namespace dsme */
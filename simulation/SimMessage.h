@@ -0,0 +1,161 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef SIMMESSAGE_H_
+#define SIMMESSAGE_H_
+
+#include "../dsmeLayer/messages/IEEE802154eMACHeader.h"
+#include "../interfaces/IDSMEMessage.h"
+#include "./SimTypes.h"
+
+namespace dsme {
+namespace sim {
+
+/**
+ * Message of the host-side simulation. The MAC header is kept as object, everything
+ * prepended by the upper layers is serialized into a flat payload buffer.
+ */
+class SimMessage : public IDSMEMessage {
+public:
+    static constexpr uint8_t MAX_PAYLOAD_LENGTH = 127;
+
+    SimMessage();
+
+    /** Prepares the message for reuse by the message pool of a node. */
+    void clear();
+
+    /** Copies header, payload and timestamps, used by the medium to hand out received frames. */
+    void copyFrom(const SimMessage& other);
+
+    /** Appends \p length dummy bytes, used by the traffic generator. */
+    bool appendPayload(uint8_t length);
+
+    uint8_t getPayloadLength() const {
+        return payloadLength;
+    }
+
+    void prependFrom(DSMEMessageElement* msg) override;
+    void decapsulateTo(DSMEMessageElement* msg) override;
+
+    bool hasPayload() override {
+        return payloadLength > 0;
+    }
+
+    uint32_t getStartOfFrameDelimiterSymbolCounter() override {
+        return startOfFrameDelimiterSymbolCounter;
+    }
+
+    void setStartOfFrameDelimiterSymbolCounter(uint32_t symbolCounter) override {
+        startOfFrameDelimiterSymbolCounter = symbolCounter;
+    }
+
+    uint16_t getTotalSymbols() override;
+    uint8_t getMPDUSymbols() override;
+
+    IEEE802154eMACHeader& getHeader() override {
+        return header;
+    }
+
+    uint8_t getLQI() override {
+        return lqi;
+    }
+
+    void setLQI(uint8_t lqi) {
+        this->lqi = lqi;
+    }
+
+    bool getReceivedViaMCPS() override {
+        return receivedViaMCPS;
+    }
+
+    void setReceivedViaMCPS(bool receivedViaMCPS) override {
+        this->receivedViaMCPS = receivedViaMCPS;
+    }
+
+    bool getCurrentlySending() override {
+        return currentlySending;
+    }
+
+    void setCurrentlySending(bool currentlySending) override {
+        this->currentlySending = currentlySending;
+    }
+
+    void increaseRetryCounter() override {
+        retryCounter++;
+    }
+
+    uint8_t getRetryCounter() override {
+        return retryCounter;
+    }
+
+    /** Virtual time the last symbol of this frame was received, used to delay the ACK by aTurnaroundTime. */
+    sim_time_t getReceptionEndTime() const {
+        return receptionEndTime;
+    }
+
+    void setReceptionEndTime(sim_time_t time) {
+        receptionEndTime = time;
+    }
+
+    /** Set while the message is handed out by the message pool of its node. */
+    bool inUse{false};
+
+private:
+    SimMessage(const SimMessage&) = delete;
+    SimMessage& operator=(const SimMessage&) = delete;
+
+    IEEE802154eMACHeader header;
+    uint8_t payload[MAX_PAYLOAD_LENGTH];
+    uint8_t payloadLength;
+
+    uint32_t startOfFrameDelimiterSymbolCounter;
+    sim_time_t receptionEndTime;
+    uint8_t lqi;
+    bool receivedViaMCPS;
+    bool currentlySending;
+    uint8_t retryCounter;
+};
+
+} /* namespace sim */
+} /* namespace dsme */
+
+#endif /* SIMMESSAGE_H_ */
@@ -0,0 +1,442 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "./SimPlatform.h"
+
+#include "../../dsme_platform.h"
+#include "../mac_services/pib/dsme_phy_constants.h"
+#include "./EventQueue.h"
+#include "./SimMedium.h"
+
+namespace dsme {
+namespace sim {
+
+SimPlatform::SimPlatform(node_id_t id, EventQueue& queue, SimMedium& medium, uint32_t seed)
+    : id(id),
+      queue(queue),
+      medium(medium),
+
+      numMessagesInUse(0),
+
+      phy_pib(),
+      mac_pib(phy_pib),
+      dsme(),
+      mcps_sap(dsme),
+      mlme_sap(dsme),
+      dsmeAdaptionLayer(dsme),
+      tpsScheduling(dsmeAdaptionLayer),
+      pidScheduling(dsmeAdaptionLayer),
+
+      channel(0),
+      transceiverOn(true),
+      transmitting(false),
+      lastTransmissionStart(0),
+      preparedMessage(nullptr),
+
+      timerGeneration(0),
+      lateEvery(0),
+      lateSymbols(0),
+      pendingReceptions(0),
+
+      randomState((seed ^ (0x9e3779b9 * (id + 1))) | 1) {
+    for(uint16_t i = 0; i < MESSAGE_POOL_SIZE; i++) {
+        freeMessages[i] = &messages[MESSAGE_POOL_SIZE - 1 - i];
+    }
+}
+
+void SimPlatform::initialize(const NodeConfig& config) {
+    channelList_t DSSS2450_channels(config.numChannels);
+    for(uint8_t i = 0; i < config.numChannels; i++) {
+        DSSS2450_channels[i] = config.commonChannel + i;
+    }
+    this->phy_pib.setDSSS2450ChannelPage(DSSS2450_channels);
+    this->phy_pib.phyCurrentChannel = config.commonChannel;
+
+    this->mac_pib.macExtendedAddress = IEEE802154MacAddress(getShortAddress());
+    this->mac_pib.macIsPANCoord = config.isPANCoordinator;
+    this->mac_pib.macIsCoord = config.isPANCoordinator;
+    this->mac_pib.macAssociatedPANCoord = config.isPANCoordinator;
+    if(config.isPANCoordinator) {
+        this->mac_pib.macPANId = config.panId;
+        this->mac_pib.macShortAddress = getShortAddress();
+    }
+    this->mac_pib.macCapReduction = config.capReduction;
+    this->mac_pib.macSuperframeOrder = config.superframeOrder;
+    this->mac_pib.macMultiSuperframeOrder = config.multiSuperframeOrder;
+    this->mac_pib.macBeaconOrder = config.beaconOrder;
+    this->mac_pib.macChannelDiversityMode = Channel_Diversity_Mode::CHANNEL_ADAPTATION;
+
+    this->dsme.setPHY_PIB(&(this->phy_pib));
+    this->dsme.setMAC_PIB(&(this->mac_pib));
+    this->dsme.setMCPS(&(this->mcps_sap));
+    this->dsme.setMLME(&(this->mlme_sap));
+
+    setChannelNumber(config.commonChannel);
+    this->dsme.initialize(this);
+    this->dsme.setTicklessSlotTimer(config.ticklessSlotTimer);
+    this->lateEvery = config.lateEvery;
+    this->lateSymbols = config.lateSymbols;
+
+    GTSScheduling* scheduling = nullptr;
+    switch(config.scheduler) {
+        case TPS_SCHEDULING:
+            this->tpsScheduling.setAlpha(0.1);
+            this->tpsScheduling.setMinFreshness(this->mac_pib.macDSMEGTSExpirationTime);
+            this->tpsScheduling.setUseHysteresis(true);
+            this->tpsScheduling.setUseMultiplePacketsPerGTS(true);
+            scheduling = &(this->tpsScheduling);
+            break;
+        case PID_SCHEDULING:
+            scheduling = &(this->pidScheduling);
+            break;
+    }
+    DSME_ASSERT(scheduling != nullptr);
+
+    channelList_t scanChannels;
+    scanChannels.add(config.commonChannel);
+    this->dsmeAdaptionLayer.initialize(scanChannels, config.beaconOrder, scheduling);
+    this->dsmeAdaptionLayer.setIndicationCallback(DELEGATE(&SimPlatform::handleDataIndication, *this));
+    this->dsmeAdaptionLayer.setConfirmCallback(DELEGATE(&SimPlatform::handleDataConfirm, *this));
+}
+
+void SimPlatform::start() {
+    this->dsme.start();
+    this->dsmeAdaptionLayer.startAssociation();
+}
+
+bool SimPlatform::sendData(uint16_t destination, uint8_t payloadLength) {
+    SimMessage* msg = static_cast<SimMessage*>(getEmptyMessage());
+    if(msg == nullptr) {
+        this->statistics.packetsDroppedNoBuffer++;
+        return false;
+    }
+
+    bool fits = msg->appendPayload(payloadLength);
+    DSME_ASSERT(fits);
+
+    msg->getHeader().setDstAddr(IEEE802154MacAddress(destination));
+    msg->getHeader().setCreationTime(getSymbolCounter());
+
+    this->statistics.packetsGenerated++;
+    this->dsmeAdaptionLayer.sendMessage(msg);
+    return true;
+}
+
+void SimPlatform::handleDataIndication(IDSMEMessage* msg) {
+    SimMessage* simMsg = static_cast<SimMessage*>(msg);
+
+    uint16_t source = msg->getHeader().getSrcAddr().getShortAddress();
+    if(source >= this->lastSequenceNumber.size()) {
+        this->lastSequenceNumber.resize(source + 1, -1);
+    }
+    if(this->lastSequenceNumber[source] == msg->getHeader().getSequenceNumber()) {
+        this->statistics.packetsDuplicate++;
+        releaseMessage(msg);
+        return;
+    }
+    this->lastSequenceNumber[source] = msg->getHeader().getSequenceNumber();
+
+    this->statistics.packetsReceived++;
+    this->statistics.bytesReceived += simMsg->getPayloadLength();
+    this->statistics.gtsLatencies.push_back(getSymbolCounter() - msg->getHeader().getCreationTime());
+
+    releaseMessage(msg);
+}
+
+void SimPlatform::handleDataConfirm(IDSMEMessage* msg, DataStatus::Data_Status status) {
+    switch(status) {
+        case DataStatus::SUCCESS:
+            this->statistics.packetsAcknowledged++;
+            break;
+        case DataStatus::TRANSACTION_OVERFLOW:
+        case DataStatus::INVALID_GTS:
+            this->statistics.packetsDroppedQueue++;
+            break;
+        case DataStatus::NO_ACK:
+            this->statistics.packetsDroppedNoAck++;
+            break;
+        default:
+            this->statistics.packetsDroppedOther++;
+            break;
+    }
+
+    releaseMessage(msg);
+}
+
+/* INTERFACE TO THE MEDIUM ------------------------------------------------> */
+
+void SimPlatform::handleFrameReception(const SimMessage& frame, sim_time_t start) {
+    SimMessage* msg = static_cast<SimMessage*>(getEmptyMessage());
+    if(msg == nullptr) {
+        LOG_ERROR("Message pool exhausted, dropping received frame.");
+        return;
+    }
+
+    msg->copyFrom(frame);
+    msg->setStartOfFrameDelimiterSymbolCounter(start + this->phy_pib.phySHRDuration);
+    msg->setReceptionEndTime(this->queue.now());
+
+    this->dsme.getAckLayer().receive(msg);
+}
+
+void SimPlatform::handleTransmissionEnd() {
+    DSME_ASSERT(this->transmitting);
+    this->transmitting = false;
+    this->preparedMessage = nullptr;
+
+    Delegate<void(bool)> callback = this->txEndCallback;
+    this->txEndCallback = Delegate<void(bool)>();
+    callback(true);
+}
+
+void SimPlatform::startTransmission() {
+    DSME_ASSERT(this->preparedMessage != nullptr);
+    DSME_ASSERT(!this->transmitting);
+
+    this->transmitting = true;
+    this->lastTransmissionStart = this->queue.now();
+    this->medium.transmit(*this, this->channel, *(this->preparedMessage));
+}
+
+/* <------------------------------------------------ INTERFACE TO THE MEDIUM */
+
+/* IDSMERadio -------------------------------------------------------------> */
+
+bool SimPlatform::setChannelNumber(uint8_t channel) {
+    if(this->transmitting) {
+        /* '-> only possible after late timers, the frame on air keeps its channel */
+        return false;
+    }
+    this->channel = channel;
+    return true;
+}
+
+uint8_t SimPlatform::getChannelNumber() {
+    return this->channel;
+}
+
+bool SimPlatform::prepareSendingCopy(IDSMEMessage* msg, Delegate<void(bool)> txEndCallback) {
+    if(this->transmitting || this->preparedMessage != nullptr) {
+        return false;
+    }
+
+    this->preparedMessage = static_cast<SimMessage*>(msg);
+    this->txEndCallback = txEndCallback;
+    return true;
+}
+
+bool SimPlatform::sendNow() {
+    if(this->preparedMessage == nullptr || this->transmitting) {
+        return false;
+    }
+
+    startTransmission();
+    return true;
+}
+
+void SimPlatform::abortPreparedTransmission() {
+    DSME_ASSERT(!this->transmitting);
+    this->preparedMessage = nullptr;
+    this->txEndCallback = Delegate<void(bool)>();
+}
+
+bool SimPlatform::sendDelayedAck(IDSMEMessage* ackMsg, IDSMEMessage* receivedMsg, Delegate<void(bool)> txEndCallback) {
+    if(!prepareSendingCopy(ackMsg, txEndCallback)) {
+        return false;
+    }
+
+    sim_time_t sendTime = static_cast<SimMessage*>(receivedMsg)->getReceptionEndTime() + aTurnaroundTime;
+    if(sendTime < this->queue.now()) {
+        sendTime = this->queue.now();
+    }
+
+    SimMessage* ack = this->preparedMessage;
+    this->queue.schedule(sendTime, this->id, [this, ack]() {
+        if(this->preparedMessage == ack && !this->transmitting) {
+            startTransmission();
+        }
+    });
+    return true;
+}
+
+void SimPlatform::setReceiveDelegate(receive_delegate_t receiveDelegate) {
+    this->receiveFromAckLayerDelegate = receiveDelegate;
+}
+
+bool SimPlatform::startCCA() {
+    this->queue.schedule(this->queue.now() + aCcaTime, this->id,
+                         [this]() { this->dsme.dispatchCCAResult(!this->transmitting && !this->medium.isChannelBusy(this->channel)); });
+    return true;
+}
+
+void SimPlatform::turnTransceiverOn() {
+    this->transceiverOn = true;
+}
+
+void SimPlatform::turnTransceiverOff() {
+    this->transceiverOn = false;
+}
+
+/* <------------------------------------------------------------- IDSMERadio */
+
+/* IDSMEPlatform ----------------------------------------------------------> */
+
+bool SimPlatform::isReceptionFromAckLayerPossible() {
+    return this->pendingReceptions < MAX_PENDING_RECEPTIONS;
+}
+
+void SimPlatform::handleReceivedMessageFromAckLayer(IDSMEMessage* message) {
+    /* decouple from the reception like an interrupt handler would */
+    this->pendingReceptions++;
+    this->queue.schedule(this->queue.now(), this->id, [this, message]() {
+        this->pendingReceptions--;
+        this->receiveFromAckLayerDelegate(message);
+    });
+}
+
+IDSMEMessage* SimPlatform::getEmptyMessage() {
+    if(this->numMessagesInUse == MESSAGE_POOL_SIZE) {
+        return nullptr;
+    }
+
+    SimMessage* msg = this->freeMessages[MESSAGE_POOL_SIZE - 1 - this->numMessagesInUse];
+    this->numMessagesInUse++;
+
+    DSME_ASSERT(!msg->inUse);
+    msg->inUse = true;
+    return msg;
+}
+
+void SimPlatform::releaseMessage(IDSMEMessage* msg) {
+    SimMessage* simMsg = static_cast<SimMessage*>(msg);
+    DSME_ASSERT(simMsg >= this->messages && simMsg < this->messages + MESSAGE_POOL_SIZE);
+    DSME_ASSERT(simMsg->inUse);
+
+    simMsg->clear();
+    simMsg->inUse = false;
+
+    this->numMessagesInUse--;
+    this->freeMessages[MESSAGE_POOL_SIZE - 1 - this->numMessagesInUse] = simMsg;
+}
+
+void SimPlatform::startTimer(uint32_t symbolCounterValue) {
+    /* the platform has a single compare register, a new timer replaces the previous one */
+    int32_t delay = static_cast<int32_t>(symbolCounterValue - getSymbolCounter());
+    if(delay < 0) {
+        delay = 0;
+    }
+
+    uint32_t generation = ++this->timerGeneration;
+    if(this->lateEvery > 0 && generation % this->lateEvery == 0) {
+        /* '-> injected lateness, as if the interrupt was held off */
+        delay += this->lateSymbols;
+    }
+    this->queue.schedule(this->queue.now() + delay, this->id, [this, generation]() {
+        if(generation == this->timerGeneration) {
+            this->dsme.getEventDispatcher().timerInterrupt();
+        }
+    });
+}
+
+uint32_t SimPlatform::getSymbolCounter() {
+    return static_cast<uint32_t>(this->queue.now());
+}
+
+uint16_t SimPlatform::getRandom() {
+    /* xorshift32, seeded per node for reproducible runs */
+    this->randomState ^= this->randomState << 13;
+    this->randomState ^= this->randomState >> 17;
+    this->randomState ^= this->randomState << 5;
+    return this->randomState >> 16;
+}
+
+void SimPlatform::updateVisual() {
+}
+
+void SimPlatform::scheduleStartOfCFP() {
+    this->queue.schedule(this->queue.now(), this->id, [this]() { this->dsme.handleStartOfCFP(); });
+}
+
+uint8_t SimPlatform::getMinCoordinatorLQI() {
+    return 0;
+}
+
+bool SimPlatform::scheduleDeferredTasks() {
+    /* the simulated CPU is idle once the current event is handled */
+    this->queue.schedule(this->queue.now(), this->id, [this]() { this->dsme.runDeferredTasks(); });
+    return true;
+}
+
+void SimPlatform::signalGTSChange(bool deallocation, IEEE802154MacAddress counterpart) {
+    if(deallocation) {
+        this->statistics.gtsDeallocations++;
+    } else {
+        this->statistics.gtsAllocations++;
+    }
+}
+
+void SimPlatform::signalQueueWatermark(bool aboveHighWatermark) {
+    if(aboveHighWatermark) {
+        this->statistics.gtsQueueCongestions++;
+    }
+}
+
+void SimPlatform::signalPacketsPerCAP(uint32_t packets) {
+    this->statistics.capPacketsSent += packets;
+}
+
+void SimPlatform::signalFailedPacketsPerCAP(uint32_t packets) {
+    this->statistics.capPacketsFailed += packets;
+}
+
+void SimPlatform::signalFailedCCAs(uint32_t failedAttempts) {
+    this->statistics.capFailedCCAs += failedAttempts;
+}
+
+void SimPlatform::signalSuccessPacketsCAP(uint32_t packets) {
+    this->statistics.capPacketsSuccessful += packets;
+}
+
+/* <---------------------------------------------------------- IDSMEPlatform */
+
+} /* namespace sim */
+} /* namespace dsme */
@@ -0,0 +1,248 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef SIMPLATFORM_H_
+#define SIMPLATFORM_H_
+
+#include <vector>
+#include "../../dsme_settings.h"
+#include "../dsmeAdaptionLayer/DSMEAdaptionLayer.h"
+#include "../dsmeAdaptionLayer/scheduling/PIDScheduling.h"
+#include "../dsmeAdaptionLayer/scheduling/TPS.h"
+#include "../dsmeLayer/DSMELayer.h"
+#include "../interfaces/IDSMEPlatform.h"
+#include "../mac_services/mcps_sap/MCPS_SAP.h"
+#include "../mac_services/mlme_sap/MLME_SAP.h"
+#include "../mac_services/pib/MAC_PIB.h"
+#include "../mac_services/pib/PHY_PIB.h"
+#include "./SimMessage.h"
+#include "./SimTypes.h"
+
+namespace dsme {
+namespace sim {
+
+class EventQueue;
+class SimMedium;
+
+enum SchedulerType { TPS_SCHEDULING, PID_SCHEDULING };
+
+struct NodeConfig {
+    bool isPANCoordinator{false};
+    uint16_t panId{0x1234};
+    uint8_t superframeOrder{3};
+    uint8_t multiSuperframeOrder{5};
+    uint8_t beaconOrder{6};
+    bool capReduction{true};
+    uint8_t commonChannel{11};
+    uint8_t numChannels{16};
+    SchedulerType scheduler{TPS_SCHEDULING};
+    bool ticklessSlotTimer{false};
+
+    /* every lateEvery-th timer interrupt fires lateSymbols late, to exercise the overload handling; 0 disables */
+    uint16_t lateEvery{0};
+    uint32_t lateSymbols{0};
+};
+
+struct NodeStatistics {
+    /* data traffic as seen by the upper layer */
+    uint64_t packetsGenerated{0};
+    uint64_t packetsAcknowledged{0};
+    uint64_t packetsReceived{0};
+    uint64_t packetsDuplicate{0}; /* retransmissions after a lost ACK, not counted as received */
+    uint64_t bytesReceived{0};
+    uint64_t packetsDroppedQueue{0};   /* confirmed with TRANSACTION_OVERFLOW or INVALID_GTS */
+    uint64_t packetsDroppedNoAck{0};
+    uint64_t packetsDroppedOther{0};
+    uint64_t packetsDroppedNoBuffer{0}; /* message pool of the node exhausted */
+
+    /* symbols from the creation of a data packet to its indication at the destination */
+    std::vector<uint32_t> gtsLatencies;
+
+    /* reported by the CAP layer via IDSMEPlatform */
+    uint64_t capPacketsSent{0};
+    uint64_t capPacketsFailed{0};
+    uint64_t capPacketsSuccessful{0};
+    uint64_t capFailedCCAs{0};
+
+    uint64_t gtsAllocations{0};
+    uint64_t gtsDeallocations{0};
+    uint64_t gtsQueueCongestions{0}; /* GTS queue reached its high watermark */
+};
+
+/**
+ * A single simulated node: implements the platform and radio interfaces on top of the
+ * virtual clock and the shared medium and hosts a complete DSMELayer and DSMEAdaptionLayer.
+ */
+class SimPlatform : public IDSMEPlatform {
+public:
+    static constexpr uint16_t MESSAGE_POOL_SIZE = TOTAL_GTS_QUEUE_SIZE + UPPER_LAYER_QUEUE_SIZE + CAP_QUEUE_SIZE + 32;
+
+    SimPlatform(node_id_t id, EventQueue& queue, SimMedium& medium, uint32_t seed);
+
+    void initialize(const NodeConfig& config);
+    void start();
+
+    /** Hands a data packet with \p payloadLength bytes for \p destination to the adaption layer. */
+    bool sendData(uint16_t destination, uint8_t payloadLength);
+
+    node_id_t getId() const {
+        return id;
+    }
+
+    uint16_t getShortAddress() const {
+        return id + 1;
+    }
+
+    bool isAssociated() {
+        return mac_pib.macAssociatedPANCoord;
+    }
+
+    DSMELayer& getDSME() {
+        return dsme;
+    }
+
+    const NodeStatistics& getStatistics() const {
+        return statistics;
+    }
+
+    uint16_t getNumMessagesInUse() const {
+        return numMessagesInUse;
+    }
+
+    /* INTERFACE TO THE MEDIUM --------------------------------------------> */
+    bool isListening(uint8_t channel) const {
+        return transceiverOn && !transmitting && this->channel == channel;
+    }
+
+    sim_time_t getLastTransmissionStart() const {
+        return lastTransmissionStart;
+    }
+
+    void handleFrameReception(const SimMessage& frame, sim_time_t start);
+    void handleTransmissionEnd();
+    /* <-------------------------------------------- INTERFACE TO THE MEDIUM */
+
+    /* IDSMERadio ---------------------------------------------------------> */
+    bool setChannelNumber(uint8_t channel) override;
+    uint8_t getChannelNumber() override;
+    bool prepareSendingCopy(IDSMEMessage* msg, Delegate<void(bool)> txEndCallback) override;
+    bool sendNow() override;
+    void abortPreparedTransmission() override;
+    bool sendDelayedAck(IDSMEMessage* ackMsg, IDSMEMessage* receivedMsg, Delegate<void(bool)> txEndCallback) override;
+    void setReceiveDelegate(receive_delegate_t receiveDelegate) override;
+    bool startCCA() override;
+    void turnTransceiverOn() override;
+    void turnTransceiverOff() override;
+    /* <--------------------------------------------------------- IDSMERadio */
+
+    /* IDSMEPlatform ------------------------------------------------------> */
+    bool isReceptionFromAckLayerPossible() override;
+    void handleReceivedMessageFromAckLayer(IDSMEMessage* message) override;
+    IDSMEMessage* getEmptyMessage() override;
+    void releaseMessage(IDSMEMessage* msg) override;
+    void startTimer(uint32_t symbolCounterValue) override;
+    uint32_t getSymbolCounter() override;
+    uint16_t getRandom() override;
+    void updateVisual() override;
+    void scheduleStartOfCFP() override;
+    bool scheduleDeferredTasks() override;
+    uint8_t getMinCoordinatorLQI() override;
+
+    void signalGTSChange(bool deallocation, IEEE802154MacAddress counterpart) override;
+    void signalQueueWatermark(bool aboveHighWatermark) override;
+    void signalPacketsPerCAP(uint32_t packets) override;
+    void signalFailedPacketsPerCAP(uint32_t packets) override;
+    void signalFailedCCAs(uint32_t failedAttempts) override;
+    void signalSuccessPacketsCAP(uint32_t packets) override;
+    /* <------------------------------------------------------ IDSMEPlatform */
+
+private:
+    /* at most this many received frames may wait to be handed to the DSME layer */
+    static constexpr uint8_t MAX_PENDING_RECEPTIONS = 4;
+
+    void handleDataIndication(IDSMEMessage* msg);
+    void handleDataConfirm(IDSMEMessage* msg, DataStatus::Data_Status status);
+
+    void startTransmission();
+
+    const node_id_t id;
+    EventQueue& queue;
+    SimMedium& medium;
+
+    /* declared before the layers, which return their queued messages when they are destroyed */
+    SimMessage messages[MESSAGE_POOL_SIZE];
+    SimMessage* freeMessages[MESSAGE_POOL_SIZE];
+    uint16_t numMessagesInUse;
+
+    PHY_PIB phy_pib;
+    MAC_PIB mac_pib;
+    DSMELayer dsme;
+    mcps_sap::MCPS_SAP mcps_sap;
+    mlme_sap::MLME_SAP mlme_sap;
+    DSMEAdaptionLayer dsmeAdaptionLayer;
+    TPS tpsScheduling;
+    PIDScheduling pidScheduling;
+
+    uint8_t channel;
+    bool transceiverOn;
+    bool transmitting;
+    sim_time_t lastTransmissionStart;
+    SimMessage* preparedMessage;
+    Delegate<void(bool)> txEndCallback;
+
+    uint32_t timerGeneration;
+    uint16_t lateEvery;
+    uint32_t lateSymbols;
+    receive_delegate_t receiveFromAckLayerDelegate;
+    uint8_t pendingReceptions;
+
+    /* sequence number of the last data frame per source short address, -1 if none was received yet */
+    std::vector<int16_t> lastSequenceNumber;
+
+    uint32_t randomState;
+    NodeStatistics statistics;
+};
+
+} /* namespace sim */
+} /* namespace dsme */
+
+#endif /* SIMPLATFORM_H_ */
@@ -0,0 +1,213 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "./Simulation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+#include "../../dsme_platform.h"
+
+namespace dsme {
+namespace sim {
+
+Simulation::Simulation(const SimulationConfig& config)
+    : config(config), queue(), medium(queue, config.seed), trafficEnd(0), randomState((config.seed * 0x2545f491) | 1) {
+    DSME_ASSERT(config.numNodes >= 1);
+
+    this->medium.setPacketErrorRate(config.packetErrorRate);
+
+    for(node_id_t id = 0; id < config.numNodes; id++) {
+        this->nodes.emplace_back(new SimPlatform(id, this->queue, this->medium, config.seed));
+        this->medium.attach(this->nodes.back().get());
+    }
+}
+
+SimulationReport Simulation::run() {
+    for(node_id_t id = 0; id < this->config.numNodes; id++) {
+        NodeConfig nodeConfig = this->config.node;
+        nodeConfig.isPANCoordinator = (id == 0);
+
+        /* the coordinator starts the PAN, the devices power up during its first second */
+        sim_time_t startTime = (id == 0) ? 0 : 1 + nextRandom() % SYMBOLS_PER_SECOND;
+        this->queue.schedule(startTime, id, [this, id, nodeConfig]() {
+            this->nodes[id]->initialize(nodeConfig);
+            this->nodes[id]->start();
+        });
+    }
+
+    sim_time_t trafficStart = (sim_time_t)this->config.warmupSeconds * SYMBOLS_PER_SECOND;
+    this->trafficEnd = trafficStart + (sim_time_t)this->config.durationSeconds * SYMBOLS_PER_SECOND;
+
+    if(this->config.packetsPerMinute > 0) {
+        for(node_id_t id = 1; id < this->config.numNodes; id++) {
+            this->queue.schedule(trafficStart, id, [this, id]() { scheduleNextPacket(id); });
+        }
+    }
+
+    /* let packets that are queued at the end of the measurement period drain for one more second */
+    this->queue.runUntil(this->trafficEnd + SYMBOLS_PER_SECOND);
+
+    SimulationReport report;
+    report.seed = this->config.seed;
+    report.numNodes = this->config.numNodes;
+    report.durationSeconds = this->config.durationSeconds;
+    report.numEvents = this->queue.getNumProcessedEvents();
+    report.medium = this->medium.getStatistics();
+
+    for(auto& node : this->nodes) {
+        const NodeStatistics& statistics = node->getStatistics();
+        MessageDispatcher& dispatcher = node->getDSME().getMessageDispatcher();
+
+        report.numAssociated += node->isAssociated() ? 1 : 0;
+        report.packetsGenerated += statistics.packetsGenerated;
+        report.packetsReceived += statistics.packetsReceived;
+        report.packetsDuplicate += statistics.packetsDuplicate;
+        report.bytesReceived += statistics.bytesReceived;
+        report.packetsDroppedQueue += statistics.packetsDroppedQueue;
+        report.packetsDroppedNoAck += statistics.packetsDroppedNoAck;
+        report.packetsDroppedOther += statistics.packetsDroppedOther;
+        report.packetsDroppedNoBuffer += statistics.packetsDroppedNoBuffer;
+
+        report.upperPacketsDroppedFullQueue += dispatcher.getNumUpperPacketsDroppedFullQueue();
+        NeighborQueue<MAX_NEIGHBORS>& neighborQueue = dispatcher.getNeighborQueue();
+        for(NeighborQueue<MAX_NEIGHBORS>::iterator it = neighborQueue.begin(); it != neighborQueue.end(); ++it) {
+            report.maxNeighborPacketsDroppedFullQueue =
+                std::max<uint64_t>(report.maxNeighborPacketsDroppedFullQueue, dispatcher.getNumUpperPacketsDroppedFullQueue(it->address));
+        }
+        report.unusedTxGTS += dispatcher.getNumUnusedTxGTS();
+        report.unusedRxGTS += dispatcher.getNumUnusedRxGTS();
+
+        report.capPacketsSent += statistics.capPacketsSent;
+        report.capPacketsFailed += statistics.capPacketsFailed;
+        report.capFailedCCAs += statistics.capFailedCCAs;
+
+        report.gtsAllocations += statistics.gtsAllocations;
+        report.gtsDeallocations += statistics.gtsDeallocations;
+        report.gtsQueueCongestions += statistics.gtsQueueCongestions;
+
+        DSMEEventDispatcher& eventDispatcher = node->getDSME().getEventDispatcher();
+        for(uint8_t timer = 0; timer < TIMER_COUNT; timer++) {
+            uint32_t lateness = eventDispatcher.getLatenessHistogram(static_cast<EventTimers>(timer)).getMax();
+            report.maxTimerLateness = std::max(report.maxTimerLateness, lateness);
+        }
+        report.maxSlotLateness = std::max(report.maxSlotLateness, eventDispatcher.getLatenessHistogram(NEXT_SLOT).getMax());
+        report.missedSlotDeadlines += node->getDSME().getNumMissedSlotDeadlines();
+
+        report.gtsLatencies.insert(report.gtsLatencies.end(), statistics.gtsLatencies.begin(), statistics.gtsLatencies.end());
+    }
+
+    return report;
+}
+
+void Simulation::scheduleNextPacket(node_id_t source) {
+    SimPlatform& node = *(this->nodes[source]);
+    if(node.isAssociated()) {
+        node.sendData(this->nodes[0]->getShortAddress(), this->config.payloadLength);
+    }
+
+    sim_time_t next = this->queue.now() + exponentialInterval(60 * (sim_time_t)SYMBOLS_PER_SECOND / this->config.packetsPerMinute);
+    if(next < this->trafficEnd) {
+        this->queue.schedule(next, source, [this, source]() { scheduleNextPacket(source); });
+    }
+}
+
+sim_time_t Simulation::exponentialInterval(sim_time_t mean) {
+    /* uniform in (0, 1], independent of the floating point details of <random> */
+    double uniform = ((nextRandom() >> 8) + 1) / 16777216.0;
+    return 1 + (sim_time_t)(-std::log(uniform) * mean);
+}
+
+uint32_t Simulation::nextRandom() {
+    /* xorshift32 */
+    this->randomState ^= this->randomState << 13;
+    this->randomState ^= this->randomState >> 17;
+    this->randomState ^= this->randomState << 5;
+    return this->randomState;
+}
+
+double SimulationReport::getGoodput() const {
+    if(this->durationSeconds == 0) {
+        return 0;
+    }
+    return 8.0 * this->bytesReceived / this->durationSeconds;
+}
+
+double SimulationReport::getDeliveryRatio() const {
+    if(this->packetsGenerated == 0) {
+        return 0;
+    }
+    return (double)this->packetsReceived / this->packetsGenerated;
+}
+
+uint32_t SimulationReport::getLatencyPercentile(uint8_t percent) const {
+    if(this->gtsLatencies.empty()) {
+        return 0;
+    }
+
+    std::vector<uint32_t> sorted(this->gtsLatencies);
+    size_t index = (sorted.size() - 1) * percent / 100;
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+void SimulationReport::print(std::ostream& stream) const {
+    stream << "seed " << this->seed << ": " << this->numAssociated << "/" << this->numNodes << " nodes associated, " << this->numEvents << " events"
+           << std::endl;
+    stream << "  data      generated " << this->packetsGenerated << ", received " << this->packetsReceived << " (" << 100 * getDeliveryRatio()
+           << " %), duplicates " << this->packetsDuplicate << ", goodput " << getGoodput() << " bit/s" << std::endl;
+    stream << "  latency   p50 " << getLatencyPercentile(50) << ", p90 " << getLatencyPercentile(90) << ", p99 " << getLatencyPercentile(99)
+           << ", max " << getLatencyPercentile(100) << " symbols" << std::endl;
+    stream << "  drops     queue " << this->packetsDroppedQueue << " (full GTS queue " << this->upperPacketsDroppedFullQueue << ", at most "
+           << this->maxNeighborPacketsDroppedFullQueue << " per neighbor), no ACK "
+           << this->packetsDroppedNoAck << ", other " << this->packetsDroppedOther << ", no buffer " << this->packetsDroppedNoBuffer << std::endl;
+    stream << "  GTS       allocated " << this->gtsAllocations << ", deallocated " << this->gtsDeallocations << ", unused TX " << this->unusedTxGTS
+           << ", unused RX " << this->unusedRxGTS << ", queue congestions " << this->gtsQueueCongestions << std::endl;
+    stream << "  CAP       sent " << this->capPacketsSent << ", failed " << this->capPacketsFailed << ", failed CCAs " << this->capFailedCCAs << std::endl;
+    stream << "  medium    frames " << this->medium.numTransmissions << ", collisions " << this->medium.numCollisions << ", lost "
+           << this->medium.numLostFrames << std::endl;
+    stream << "  timers    max lateness " << this->maxTimerLateness << " symbols (slot " << this->maxSlotLateness << "), missed slot deadlines "
+           << this->missedSlotDeadlines << std::endl;
+}
+
+} /* namespace sim */
+} /* namespace dsme */
@@ -0,0 +1,162 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef SIMULATION_H_
+#define SIMULATION_H_
+
+#include <iosfwd>
+#include <memory>
+#include <vector>
+#include "./EventQueue.h"
+#include "./SimMedium.h"
+#include "./SimPlatform.h"
+#include "./SimTypes.h"
+
+namespace dsme {
+namespace sim {
+
+struct SimulationConfig {
+    uint16_t numNodes{8}; /* including the PAN coordinator (node 0) */
+    NodeConfig node{};
+
+    uint32_t seed{1};
+    uint32_t warmupSeconds{60};   /* association and beacon allocation, no data traffic */
+    uint32_t durationSeconds{120}; /* measurement period with data traffic */
+
+    /* every device sends to the PAN coordinator with exponentially distributed inter-arrival times */
+    uint32_t packetsPerMinute{60};
+    uint8_t payloadLength{20};
+
+    uint16_t packetErrorRate{0}; /* per mille */
+};
+
+/**
+ * Results of a single run, aggregated over all nodes.
+ */
+struct SimulationReport {
+    uint32_t seed{0};
+    uint16_t numNodes{0};
+    uint16_t numAssociated{0};
+    uint32_t durationSeconds{0};
+    uint64_t numEvents{0};
+
+    uint64_t packetsGenerated{0};
+    uint64_t packetsReceived{0};
+    uint64_t packetsDuplicate{0};
+    uint64_t bytesReceived{0};
+    uint64_t packetsDroppedQueue{0};
+    uint64_t packetsDroppedNoAck{0};
+    uint64_t packetsDroppedOther{0};
+    uint64_t packetsDroppedNoBuffer{0};
+
+    /* counters of the MessageDispatcher */
+    uint64_t upperPacketsDroppedFullQueue{0};
+    uint64_t maxNeighborPacketsDroppedFullQueue{0};
+    uint64_t unusedTxGTS{0};
+    uint64_t unusedRxGTS{0};
+
+    /* counters of the CAPLayer */
+    uint64_t capPacketsSent{0};
+    uint64_t capPacketsFailed{0};
+    uint64_t capFailedCCAs{0};
+
+    uint64_t gtsAllocations{0};
+    uint64_t gtsDeallocations{0};
+    uint64_t gtsQueueCongestions{0};
+
+    /* timer lateness in symbols and slots served too late, see DSMELayer::getNumMissedSlotDeadlines() */
+    uint32_t maxSlotLateness{0};
+    uint32_t maxTimerLateness{0};
+    uint64_t missedSlotDeadlines{0};
+
+    MediumStatistics medium;
+
+    /* end-to-end latencies of all received data packets in symbols */
+    std::vector<uint32_t> gtsLatencies;
+
+    /** Received payload in bit/s over the measurement period. */
+    double getGoodput() const;
+
+    double getDeliveryRatio() const;
+
+    /** Latency in symbols below which \p percent of the received packets were delivered. */
+    uint32_t getLatencyPercentile(uint8_t percent) const;
+
+    void print(std::ostream& stream) const;
+};
+
+/**
+ * Deterministic discrete-event simulation of a single PAN. All nodes share one virtual
+ * clock and one medium and are executed by the calling thread, so runs with the same
+ * configuration and seed produce identical results.
+ */
+class Simulation {
+public:
+    explicit Simulation(const SimulationConfig& config);
+
+    SimulationReport run();
+
+    EventQueue& getEventQueue() {
+        return queue;
+    }
+
+    SimPlatform& getNode(node_id_t id) {
+        return *(nodes[id]);
+    }
+
+private:
+    void scheduleNextPacket(node_id_t source);
+    sim_time_t exponentialInterval(sim_time_t mean);
+    uint32_t nextRandom();
+
+    SimulationConfig config;
+    EventQueue queue;
+    SimMedium medium;
+    std::vector<std::unique_ptr<SimPlatform>> nodes;
+    sim_time_t trafficEnd;
+    uint32_t randomState;
+};
+
+} /* namespace sim */
+} /* namespace dsme */
+
+#endif /* SIMULATION_H_ */
@@ -0,0 +1,115 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "./SimulationRunner.h"
+
+#include <ostream>
+#include "./WorkStealingPool.h"
+
+namespace dsme {
+namespace sim {
+
+void SimulationRunner::add(const SimulationConfig& config) {
+    runs.emplace_back();
+    runs.back().config = config;
+}
+
+const std::vector<SimulationRun>& SimulationRunner::run(unsigned numThreads) {
+    WorkStealingPool pool(numThreads);
+
+    for(SimulationRun& run : runs) {
+        SimulationRun* current = &run;
+        pool.submit([current]() {
+            Simulation simulation(current->config);
+            current->report = simulation.run();
+        });
+    }
+
+    pool.wait();
+    return runs;
+}
+
+static void printLine(std::ostream& stream, const SimulationReport& report) {
+    stream << report.numAssociated << "," << report.packetsGenerated << "," << report.packetsReceived << "," << report.getGoodput() << ","
+           << report.getLatencyPercentile(50) << "," << report.getLatencyPercentile(90) << "," << report.getLatencyPercentile(99) << ","
+           << report.packetsDroppedQueue << "," << report.upperPacketsDroppedFullQueue << "," << report.unusedTxGTS << "," << report.unusedRxGTS << ","
+           << report.capPacketsSent << "," << report.capPacketsFailed << "," << report.capFailedCCAs << std::endl;
+}
+
+void SimulationRunner::printReport(std::ostream& stream) const {
+    stream << "run,nodes,so,mo,bo,scheduler,gts_queue,seed,associated,generated,received,goodput_bps,latency_p50,latency_p90,latency_p99,dropped_queue,"
+              "dropped_full_gts_queue,unused_tx_gts,unused_rx_gts,cap_sent,cap_failed,cap_failed_ccas"
+           << std::endl;
+
+    SimulationReport total;
+    for(size_t i = 0; i < runs.size(); i++) {
+        const SimulationConfig& config = runs[i].config;
+        const SimulationReport& report = runs[i].report;
+
+        stream << i << "," << config.numNodes << "," << (uint16_t)config.node.superframeOrder << "," << (uint16_t)config.node.multiSuperframeOrder << ","
+               << (uint16_t)config.node.beaconOrder << "," << (config.node.scheduler == TPS_SCHEDULING ? "tps" : "pid") << "," << TOTAL_GTS_QUEUE_SIZE << ","
+               << config.seed << ",";
+        printLine(stream, report);
+
+        total.numNodes += report.numNodes;
+        total.numAssociated += report.numAssociated;
+        total.durationSeconds += report.durationSeconds;
+        total.packetsGenerated += report.packetsGenerated;
+        total.packetsReceived += report.packetsReceived;
+        total.bytesReceived += report.bytesReceived;
+        total.packetsDroppedQueue += report.packetsDroppedQueue;
+        total.upperPacketsDroppedFullQueue += report.upperPacketsDroppedFullQueue;
+        total.unusedTxGTS += report.unusedTxGTS;
+        total.unusedRxGTS += report.unusedRxGTS;
+        total.capPacketsSent += report.capPacketsSent;
+        total.capPacketsFailed += report.capPacketsFailed;
+        total.capFailedCCAs += report.capFailedCCAs;
+        total.gtsLatencies.insert(total.gtsLatencies.end(), report.gtsLatencies.begin(), report.gtsLatencies.end());
+    }
+
+    /* goodput of the total is the mean per run, latencies are pooled over all runs */
+    stream << "all," << total.numNodes << ",,,,,,,";
+    printLine(stream, total);
+}
+
+} /* namespace sim */
+} /* namespace dsme */
@@ -0,0 +1,161 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "./Benchmark.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+
+/*
+ * The benchmark binary replaces the global allocation functions to count heap allocations.
+ * This file must therefore only be linked into the benchmark and never into the library.
+ */
+static std::atomic<uint64_t> numAllocations(0);
+
+void* operator new(std::size_t size) {
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if(p == nullptr) {
+        std::abort();
+    }
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace dsme {
+namespace sim {
+
+uint64_t getNumAllocations() {
+    return numAllocations.load(std::memory_order_relaxed);
+}
+
+Benchmark::Benchmark(const std::string& filter, double minSeconds) : filter(filter), minSeconds(minSeconds) {
+}
+
+bool Benchmark::isSelected(const std::string& name) const {
+    return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+void Benchmark::run(const std::string& name, uint32_t size, uint32_t operationsPerRun, const function_t& body) {
+    run(name, size, operationsPerRun, nullptr, body);
+}
+
+void Benchmark::run(const std::string& name, uint32_t size, uint32_t operationsPerRun, const function_t& setup, const function_t& body) {
+    if(!isSelected(name)) {
+        return;
+    }
+
+    typedef std::chrono::steady_clock clock;
+
+    /* one unmeasured run to warm up caches and to fault in lazily allocated memory */
+    if(setup) {
+        setup();
+    }
+    body();
+
+    /*
+     * Without a setup the body is repeated in batches between two clock readings, so the
+     * overhead of reading the clock does not dominate bodies that take only a few nanoseconds.
+     */
+    uint64_t batchSize = 1;
+    clock::duration elapsed(0);
+    uint64_t allocations = 0;
+    uint64_t runs = 0;
+    while(std::chrono::duration<double>(elapsed).count() < minSeconds) {
+        if(setup) {
+            setup();
+        }
+
+        uint64_t allocationsBefore = getNumAllocations();
+        clock::time_point start = clock::now();
+        for(uint64_t i = 0; i < batchSize; i++) {
+            body();
+        }
+        clock::duration batchTime = clock::now() - start;
+        elapsed += batchTime;
+        allocations += getNumAllocations() - allocationsBefore;
+        runs += batchSize;
+
+        if(!setup && batchTime < std::chrono::microseconds(100)) {
+            batchSize *= 2;
+        }
+    }
+
+    BenchmarkResult result;
+    result.name = name;
+    result.size = size;
+    result.operations = runs * operationsPerRun;
+    result.nanosecondsPerOperation = std::chrono::duration<double, std::nano>(elapsed).count() / result.operations;
+    result.allocationsPerOperation = (double)allocations / result.operations;
+    results.push_back(result);
+}
+
+void Benchmark::printReport(std::ostream& stream) const {
+    stream << "benchmark,size,operations,ns_per_op,allocs_per_op" << std::endl;
+    for(const BenchmarkResult& result : results) {
+        stream << result.name << "," << result.size << "," << result.operations << "," << result.nanosecondsPerOperation << ","
+               << result.allocationsPerOperation << std::endl;
+    }
+}
+
+} /* namespace sim */
+} /* namespace dsme */
@@ -0,0 +1,105 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "../../helper/Integers.h"
+
+namespace dsme {
+namespace sim {
+
+struct BenchmarkResult {
+    std::string name;
+    uint32_t size;
+    uint64_t operations;
+    double nanosecondsPerOperation;
+    double allocationsPerOperation;
+};
+
+/**
+ * Minimal harness for microbenchmarks of the openDSME data structures. A benchmark body performs a
+ * fixed number of operations and is repeated until the minimum measurement time has passed. Only
+ * the body is timed, the optional setup runs before every repetition and is excluded from both time
+ * and heap allocation counts.
+ */
+class Benchmark {
+public:
+    typedef std::function<void()> function_t;
+
+    Benchmark(const std::string& filter, double minSeconds);
+
+    /** Returns true if the benchmark \p name is selected by the filter and should be prepared at all. */
+    bool isSelected(const std::string& name) const;
+
+    void run(const std::string& name, uint32_t size, uint32_t operationsPerRun, const function_t& body);
+    void run(const std::string& name, uint32_t size, uint32_t operationsPerRun, const function_t& setup, const function_t& body);
+
+    const std::vector<BenchmarkResult>& getResults() const {
+        return results;
+    }
+
+    void printReport(std::ostream& stream) const;
+
+private:
+    std::string filter;
+    double minSeconds;
+    std::vector<BenchmarkResult> results;
+};
+
+/** Number of calls to the global operator new since program start. */
+uint64_t getNumAllocations();
+
+/** Prevents the compiler from optimizing away a computed \p value. */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} /* namespace sim */
+} /* namespace dsme */
+
+#endif /* BENCHMARK_H_ */
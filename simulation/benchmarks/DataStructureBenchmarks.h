@@ -0,0 +1,525 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef DATASTRUCTUREBENCHMARKS_H_
+#define DATASTRUCTUREBENCHMARKS_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "../../dsmeLayer/DSMELayer.h"
+#include "../../dsmeLayer/TimerQueue.h"
+#include "../../dsmeLayer/neighbors/NeighborListEntry.h"
+#include "../../dsmeLayer/neighbors/NeighborQueue.h"
+#include "../../helper/DSMERingbuffer.h"
+#include "../../mac_services/dataStructures/DSMEBitVector.h"
+#include "../../mac_services/pib/MAC_PIB.h"
+#include "./Benchmark.h"
+
+namespace dsme {
+namespace sim {
+
+/*
+ * The benchmarks are templates over the benchmarked container, so an alternative implementation
+ * with the same interface can be measured side by side with the current one by instantiating the
+ * same template under another name.
+ */
+
+/** Returns a pseudo-random permutation of 0 .. size-1, identical for equal seeds. */
+inline std::vector<uint16_t> shuffledSequence(uint16_t size, uint32_t seed) {
+    std::vector<uint16_t> sequence(size);
+    for(uint16_t i = 0; i < size; i++) {
+        sequence[i] = i;
+    }
+    for(uint16_t i = size; i > 1; i--) {
+        seed = seed * 1103515245 + 12345;
+        uint16_t j = (seed >> 16) % i;
+        uint16_t tmp = sequence[i - 1];
+        sequence[i - 1] = sequence[j];
+        sequence[j] = tmp;
+    }
+    return sequence;
+}
+
+/**
+ * Containers with the interface of RBTree<uint16_t, uint16_t, N>:
+ * insert(obj, key), find(key), remove(iterator&), begin() and end().
+ */
+template <typename MAP>
+void benchmarkMap(Benchmark& bench, const std::string& name, uint16_t size) {
+    std::vector<uint16_t> keys = shuffledSequence(size, 1);
+    std::unique_ptr<MAP> map;
+
+    auto create = [&]() { map.reset(new MAP()); };
+    auto fill = [&]() {
+        create();
+        for(uint16_t key : keys) {
+            map->insert(key, key);
+        }
+    };
+
+    bench.run(name + "/insert", size, size, create, [&]() {
+        for(uint16_t key : keys) {
+            map->insert(key, key);
+        }
+    });
+
+    fill();
+    bench.run(name + "/find", size, size, [&]() {
+        for(uint16_t key : keys) {
+            auto it = map->find(key);
+            doNotOptimize(*it);
+        }
+    });
+
+    bench.run(name + "/iterate", size, size, [&]() {
+        uint32_t sum = 0;
+        for(auto it = map->begin(); it != map->end(); ++it) {
+            sum += *it;
+        }
+        doNotOptimize(sum);
+    });
+
+    /* includes the find() that yields the iterator to remove */
+    bench.run(name + "/remove", size, size, fill, [&]() {
+        for(uint16_t key : keys) {
+            auto it = map->find(key);
+            map->remove(it);
+        }
+    });
+}
+
+/** Bit vectors with the interface of BitVector<N>, \p size has to be a multiple of 8. */
+template <typename BV>
+void benchmarkBitVector(Benchmark& bench, const std::string& name, bit_vector_size_t size) {
+    std::vector<uint16_t> positions = shuffledSequence(size, 2);
+    BV vector;
+    vector.setLength(size);
+    for(bit_vector_size_t i = 0; i < size; i += 2) {
+        vector.set(positions[i], true);
+    }
+
+    bench.run(name + "/set", size, size, [&]() {
+        for(bit_vector_size_t i = 0; i < size; i++) {
+            vector.set(positions[i], i & 1);
+        }
+    });
+
+    bench.run(name + "/get", size, size, [&]() {
+        uint16_t numSet = 0;
+        for(uint16_t position : positions) {
+            numSet += vector.get(position);
+        }
+        doNotOptimize(numSet);
+    });
+
+    bench.run(name + "/count", size, 1, [&]() { doNotOptimize(vector.count(true)); });
+
+    bench.run(name + "/isZero", size, 1, [&]() { doNotOptimize(vector.isZero()); });
+
+    /* half of the bits are set, one operation per visited bit */
+    bench.run(name + "/iterateSet", size, size / 2, [&]() {
+        uint32_t sum = 0;
+        for(auto it = vector.beginSetBits(); it != vector.endSetBits(); ++it) {
+            sum += *it;
+        }
+        doNotOptimize(sum);
+    });
+
+    bench.run(name + "/iterateUnset", size, size / 2, [&]() {
+        uint32_t sum = 0;
+        for(auto it = vector.beginUnsetBits(); it != vector.endUnsetBits(); ++it) {
+            sum += *it;
+        }
+        doNotOptimize(sum);
+    });
+
+    /* a sparse vector as seen when searching a SAB sub block for one or two allocated slots, one operation per scan */
+    BV sparse;
+    sparse.setLength(size);
+    sparse.set(size / 3, true);
+    sparse.set(size - 1, true);
+    bench.run(name + "/iterateSparse", size, 1, [&]() {
+        uint32_t sum = 0;
+        for(auto it = sparse.beginSetBits(); it != sparse.endSetBits(); ++it) {
+            sum += *it;
+        }
+        doNotOptimize(sum);
+    });
+
+    /* a sub block of a quarter of the vector, merged at a byte-aligned and at an unaligned offset */
+    BV subBlock;
+    subBlock.setLength(size / 4);
+    for(bit_vector_size_t i = 0; i < size / 4; i += 3) {
+        subBlock.set(i, true);
+    }
+    BV target;
+    target.setLength(size);
+
+    bench.run(name + "/joinAligned", size, 1, [&]() {
+        target.setOperationJoin(subBlock, size / 2);
+        doNotOptimize(target);
+    });
+
+    bench.run(name + "/joinUnaligned", size, 1, [&]() {
+        target.setOperationJoin(subBlock, size / 2 + 3);
+        doNotOptimize(target);
+    });
+
+    bench.run(name + "/complementAligned", size, 1, [&]() {
+        target.setOperationComplement(subBlock, size / 2);
+        doNotOptimize(target);
+    });
+
+    bench.run(name + "/complementUnaligned", size, 1, [&]() {
+        target.setOperationComplement(subBlock, size / 2 + 3);
+        doNotOptimize(target);
+    });
+
+    bench.run(name + "/extractAligned", size, 1, [&]() {
+        subBlock.copyFrom(vector, size / 2);
+        doNotOptimize(subBlock);
+    });
+
+    bench.run(name + "/extractUnaligned", size, 1, [&]() {
+        subBlock.copyFrom(vector, size / 2 + 3);
+        doNotOptimize(subBlock);
+    });
+}
+
+/**
+ * Queues with the interface of MultiMessageQueue<T, S>, filled round-robin for \p numNeighbors
+ * neighbors until the shared capacity \p capacity is exhausted.
+ */
+template <typename QUEUE, typename T>
+void benchmarkMultiMessageQueue(Benchmark& bench, const std::string& name, uint16_t numNeighbors, uint16_t capacity) {
+    std::vector<std::unique_ptr<NeighborListEntry<T>>> neighbors;
+    for(uint16_t i = 0; i < numNeighbors; i++) {
+        Neighbor neighbor(IEEE802154MacAddress(i + 1));
+        neighbors.emplace_back(new NeighborListEntry<T>(neighbor));
+    }
+    std::vector<T> messages(capacity);
+    QUEUE queue;
+
+    auto fill = [&]() {
+        for(uint16_t i = 0; i < capacity; i++) {
+            queue.push_back(*neighbors[i % numNeighbors], &messages[i]);
+        }
+    };
+    auto drain = [&]() {
+        for(auto& neighbor : neighbors) {
+            queue.flush(*neighbor, false);
+        }
+    };
+
+    bench.run(name + "/push_back", capacity, capacity, drain, fill);
+    drain();
+
+    bench.run(name + "/front+pop_front", capacity, capacity, fill, [&]() {
+        for(uint16_t i = 0; i < capacity; i++) {
+            NeighborListEntry<T>& neighbor = *neighbors[i % numNeighbors];
+            doNotOptimize(queue.front(neighbor));
+            doNotOptimize(queue.pop_front(neighbor));
+        }
+    });
+
+    /* one operation per flushed message */
+    bench.run(name + "/flush", capacity, capacity, fill, drain);
+    drain();
+}
+
+/**
+ * Neighbor lists with the interface of NeighborQueue<N>: addNeighbor(neighbor), findByAddress(address),
+ * eraseNeighbor(iterator&), begin() and end(). The neighbors are known by their short addresses.
+ */
+template <typename NEIGHBORS>
+void benchmarkNeighborQueue(Benchmark& bench, const std::string& name, uint16_t size) {
+    std::vector<uint16_t> addresses = shuffledSequence(size, 1);
+    std::unique_ptr<NEIGHBORS> neighbors;
+
+    auto create = [&]() { neighbors.reset(new NEIGHBORS()); };
+    auto fill = [&]() {
+        create();
+        for(uint16_t address : addresses) {
+            Neighbor neighbor(IEEE802154MacAddress(address + 1));
+            neighbors->addNeighbor(neighbor);
+        }
+    };
+
+    bench.run(name + "/addNeighbor", size, size, create, [&]() {
+        for(uint16_t address : addresses) {
+            Neighbor neighbor(IEEE802154MacAddress(address + 1));
+            neighbors->addNeighbor(neighbor);
+        }
+    });
+
+    fill();
+    bench.run(name + "/findByAddress", size, size, [&]() {
+        for(uint16_t address : addresses) {
+            auto it = neighbors->findByAddress(IEEE802154MacAddress(address + 1));
+            doNotOptimize(it->queueSize);
+        }
+    });
+
+    bench.run(name + "/iterate", size, size, [&]() {
+        uint32_t sum = 0;
+        for(auto it = neighbors->begin(); it != neighbors->end(); ++it) {
+            sum += it->queueSize;
+        }
+        doNotOptimize(sum);
+    });
+
+    /* includes the findByAddress() that yields the iterator to erase */
+    bench.run(name + "/eraseNeighbor", size, size, fill, [&]() {
+        for(uint16_t address : addresses) {
+            auto it = neighbors->findByAddress(IEEE802154MacAddress(address + 1));
+            neighbors->eraseNeighbor(it);
+        }
+    });
+}
+
+/** Queues with the interface of DSMEQueue<T, N>, filled to capacity and drained again. */
+template <typename QUEUE>
+void benchmarkQueue(Benchmark& bench, const std::string& name, uint16_t capacity) {
+    QUEUE queue;
+
+    bench.run(name + "/push+pop", capacity, capacity, [&]() {
+        for(uint16_t i = 0; i < capacity; i++) {
+            queue.push(i);
+        }
+        for(uint16_t i = 0; i < capacity; i++) {
+            doNotOptimize(queue.front());
+            queue.pop();
+        }
+    });
+}
+
+/** Ring buffers with the interface of DSMERingBuffer<T, N>, filled to capacity and drained again. */
+template <typename RINGBUFFER>
+void benchmarkRingBuffer(Benchmark& bench, const std::string& name, uint16_t capacity) {
+    RINGBUFFER buffer;
+
+    bench.run(name + "/push+pop", capacity, capacity, [&]() {
+        for(uint16_t i = 0; i < capacity && !buffer.isFull(); i++) {
+            *buffer.freeElement() = i;
+            buffer.pushFreeElement();
+        }
+        while(!buffer.isEmpty()) {
+            doNotOptimize(*buffer.front());
+            buffer.pop();
+        }
+    });
+}
+
+/** Ring buffers with the claim()/publish() interface of DSMEMPSCRingBuffer<T, N>, filled to capacity and drained again. */
+template <typename RINGBUFFER>
+void benchmarkClaimingRingBuffer(Benchmark& bench, const std::string& name, uint16_t capacity) {
+    RINGBUFFER buffer;
+
+    bench.run(name + "/push+pop", capacity, capacity, [&]() {
+        ringbuffer_size_t position;
+        for(uint16_t i = 0; i < capacity; i++) {
+            uint16_t* element = buffer.claim(position);
+            if(element == nullptr) {
+                break;
+            }
+            *element = i;
+            buffer.publish(position);
+        }
+        for(uint16_t* element = buffer.front(); element != nullptr; element = buffer.front()) {
+            doNotOptimize(*element);
+            buffer.pop();
+        }
+    });
+}
+
+/**
+ * Deadline queues with the interface of TimerHeapQueue<N>, holding \p numTimers armed timers with
+ * distinct deadlines in random order.
+ */
+template <typename QUEUE>
+void benchmarkTimerQueue(Benchmark& bench, const std::string& name, uint16_t numTimers) {
+    std::vector<uint16_t> order = shuffledSequence(numTimers, 4);
+    QUEUE queue;
+
+    auto clear = [&]() { queue.clear(); };
+    auto fill = [&]() {
+        for(uint16_t id = 0; id < numTimers; id++) {
+            queue.arm(id, 16 * order[id]);
+        }
+    };
+
+    bench.run(name + "/arm", numTimers, numTimers, clear, fill);
+
+    clear();
+    fill();
+    bench.run(name + "/top", numTimers, 1, [&]() { doNotOptimize(queue.topDeadline()); });
+
+    /* the dispatch path of a periodic timer: fetch the earliest one and arm it again one period later */
+    uint32_t period = 16 * numTimers;
+    bench.run(name + "/expire+rearm", numTimers, numTimers, [&]() {
+        for(uint16_t i = 0; i < numTimers; i++) {
+            uint16_t id = queue.top();
+            queue.arm(id, queue.topDeadline() + period);
+        }
+    });
+
+    bench.run(name + "/cancel", numTimers, numTimers, fill, [&]() {
+        for(uint16_t id : order) {
+            queue.cancel(id);
+        }
+    });
+}
+
+/**
+ * Allocation counter tables with the interface of DSMEAllocationCounterTable, filled with every
+ * GTS of the multi-superframe that is configured in the MAC PIB of \p dsme.
+ */
+template <typename ACT>
+void benchmarkACT(Benchmark& bench, const std::string& name, DSMELayer& dsme) {
+    PIBHelper& helper = dsme.getMAC_PIB().helper;
+    uint8_t numSuperframes = helper.getNumberSuperframesPerMultiSuperframe();
+    uint8_t numChannels = helper.getNumChannels();
+
+    struct Slot {
+        uint16_t superframeID;
+        uint8_t gtSlotID;
+    };
+    std::vector<Slot> slots;
+    for(uint8_t superframeID = 0; superframeID < numSuperframes; superframeID++) {
+        for(uint8_t gtSlotID = 0; gtSlotID < helper.getNumGTSlots(superframeID); gtSlotID++) {
+            slots.push_back(Slot{superframeID, gtSlotID});
+        }
+    }
+    uint16_t size = slots.size();
+    std::vector<uint16_t> order = shuffledSequence(size, 3);
+
+    ACT act;
+    act.initialize(numSuperframes, helper.getNumGTSlots(0), helper.getNumGTSlots(1), numChannels, &dsme);
+
+    auto fill = [&]() {
+        for(uint16_t i = 0; i < size; i++) {
+            const Slot& slot = slots[order[i]];
+            act.add(slot.superframeID, slot.gtSlotID, i % numChannels, (i & 1) ? RX : TX, 1 + (i % MAX_NEIGHBORS), VALID);
+        }
+    };
+    auto clear = [&]() { act.clear(); };
+
+    bench.run(name + "/add", size, size, clear, fill);
+
+    clear();
+    fill();
+    bench.run(name + "/find", size, size, [&]() {
+        for(uint16_t i : order) {
+            auto it = act.find(slots[i].superframeID, slots[i].gtSlotID);
+            doNotOptimize(it->getAddress());
+        }
+    });
+
+    bench.run(name + "/isAllocated", size, size, [&]() {
+        uint16_t numAllocated = 0;
+        for(uint16_t i : order) {
+            numAllocated += act.isAllocated(slots[i].superframeID, slots[i].gtSlotID);
+        }
+        doNotOptimize(numAllocated);
+    });
+
+    bench.run(name + "/iterate", size, size, [&]() {
+        uint32_t sum = 0;
+        for(auto it = act.begin(); it != act.end(); ++it) {
+            sum += it->getAddress();
+        }
+        doNotOptimize(sum);
+    });
+
+    bench.run(name + "/getNumAllocatedGTS", size, MAX_NEIGHBORS, [&]() {
+        uint32_t sum = 0;
+        for(uint16_t address = 1; address <= MAX_NEIGHBORS; address++) {
+            sum += act.getNumAllocatedGTS(address, TX);
+        }
+        doNotOptimize(sum);
+    });
+
+    bench.run(name + "/iterateSuperframe", size, 1, [&]() {
+        uint32_t sum = 0;
+        auto last = act.endSuperframe(numSuperframes - 1);
+        for(auto it = act.beginSuperframe(numSuperframes - 1); it != last; ++it) {
+            sum += it->getGTSlotID();
+        }
+        doNotOptimize(sum);
+    });
+
+    bench.run(name + "/iterateRX", size, size / 2, [&]() {
+        uint32_t sum = 0;
+        for(auto it = act.beginRX(); it != act.end(); ++it) {
+            sum += it->getIdleCounter();
+        }
+        doNotOptimize(sum);
+    });
+
+    /* one neighbor holds about size / (2 * MAX_NEIGHBORS) of the slots in each direction */
+    bench.run(name + "/iterateNeighbor", size, 1, [&]() {
+        uint32_t sum = 0;
+        for(auto it = act.beginNeighbor(1, TX); it != act.end(); ++it) {
+            sum += it->getIdleCounter();
+        }
+        doNotOptimize(sum);
+    });
+
+    /* includes the find() that yields the iterator to remove */
+    auto refill = [&]() {
+        clear();
+        fill();
+    };
+    bench.run(name + "/remove", size, size, refill, [&]() {
+        for(uint16_t i : order) {
+            act.remove(act.find(slots[i].superframeID, slots[i].gtSlotID));
+        }
+    });
+
+    act.clear();
+}
+
+} /* namespace sim */
+} /* namespace dsme */
+
+#endif /* DATASTRUCTUREBENCHMARKS_H_ */
@@ -0,0 +1,144 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/*
+ * Microbenchmarks for the data structures on the slot timing critical path. Compile this file
+ * and Benchmark.cc together with the openDSME sources and the host-side simulation (see
+ * dsme_sim.cc), but never link Benchmark.cc into anything else since it replaces the global
+ * operator new to count heap allocations.
+ *
+ * To judge an alternative implementation, instantiate the benchmark template of the replaced
+ * structure a second time with the new type and a distinct name below.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "../../../dsme_platform.h"
+#include "../../dsmeLayer/DSMEEventDispatcher.h"
+#include "../../dsmeLayer/TimerQueue.h"
+#include "../../dsmeLayer/neighbors/MultiMessageQueue.h"
+#include "../../helper/DSMEQueue.h"
+#include "../../helper/DSMERingbuffer.h"
+#include "../../mac_services/dataStructures/DSMEAllocationCounterTable.h"
+#include "../../mac_services/dataStructures/RBTree.h"
+#include "../EventQueue.h"
+#include "../SimMedium.h"
+#include "../SimPlatform.h"
+#include "./Benchmark.h"
+#include "./DataStructureBenchmarks.h"
+
+using namespace dsme;
+using namespace dsme::sim;
+
+static void printUsage(const char* name) {
+    std::cerr << "Usage: " << name << " [options]" << std::endl;
+    std::cerr << "  --filter STRING  only run benchmarks whose name contains STRING" << std::endl;
+    std::cerr << "  --time MS        minimum measurement time per benchmark in milliseconds (default 200)" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::string filter;
+    double minSeconds = 0.2;
+
+    for(int i = 1; i < argc; i++) {
+        if(i + 1 >= argc) {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        const char* option = argv[i];
+        const char* value = argv[++i];
+
+        if(strcmp(option, "--filter") == 0) {
+            filter = value;
+        } else if(strcmp(option, "--time") == 0) {
+            minSeconds = strtoul(value, nullptr, 0) / 1000.0;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    Benchmark bench(filter, minSeconds);
+
+    /* neighbor lists and per-neighbor counters */
+    benchmarkMap<RBTree<uint16_t, uint16_t, MAX_NEIGHBORS>>(bench, "RBTree", MAX_NEIGHBORS);
+    /* one entry per GTS and channel of a superframe */
+    benchmarkMap<RBTree<uint16_t, uint16_t, MAX_GTSLOTS * MAX_CHANNELS>>(bench, "RBTree", MAX_GTSLOTS * MAX_CHANNELS);
+
+    /* SAB sub block of one superframe and the complete SAB of a multi-superframe */
+    benchmarkBitVector<BitVector<MAX_GTSLOTS * MAX_CHANNELS>>(bench, "BitVector", MAX_GTSLOTS * MAX_CHANNELS);
+    benchmarkBitVector<BitVector<MAX_SUPERFRAMES_PER_MULTI_SUPERFRAME * MAX_GTSLOTS * MAX_CHANNELS>>(
+        bench, "BitVector", MAX_SUPERFRAMES_PER_MULTI_SUPERFRAME * MAX_GTSLOTS * MAX_CHANNELS);
+
+    benchmarkMultiMessageQueue<MultiMessageQueue<int, TOTAL_GTS_QUEUE_SIZE>, int>(bench, "MultiMessageQueue", MAX_NEIGHBORS, TOTAL_GTS_QUEUE_SIZE);
+
+    benchmarkNeighborQueue<NeighborQueue<MAX_NEIGHBORS>>(bench, "NeighborQueue", MAX_NEIGHBORS);
+
+    benchmarkQueue<DSMEQueue<uint16_t, UPPER_LAYER_QUEUE_SIZE>>(bench, "DSMEQueue", UPPER_LAYER_QUEUE_SIZE);
+
+    benchmarkRingBuffer<DSMERingBuffer<uint16_t, CAP_QUEUE_SIZE>>(bench, "DSMERingBuffer", CAP_QUEUE_SIZE);
+    /* the event buffers of the FSMs */
+    benchmarkRingBuffer<DSMERingBuffer<uint16_t, 32>>(bench, "DSMERingBuffer", 32);
+    benchmarkClaimingRingBuffer<DSMEMPSCRingBuffer<uint16_t, 32>>(bench, "DSMEMPSCRingBuffer", 32);
+
+    /* the timers of the DSMEEventDispatcher and a set as large as with per-message and per-neighbor timers */
+    benchmarkTimerQueue<TimerScanQueue<TIMER_COUNT>>(bench, "TimerScanQueue", TIMER_COUNT);
+    benchmarkTimerQueue<TimerHeapQueue<TIMER_COUNT>>(bench, "TimerHeapQueue", TIMER_COUNT);
+    benchmarkTimerQueue<TimerScanQueue<64>>(bench, "TimerScanQueue", 64);
+    benchmarkTimerQueue<TimerHeapQueue<64>>(bench, "TimerHeapQueue", 64);
+
+    /* the ACT needs a DSME layer with a configured MAC PIB, SO 3 and MO 6 yield 8 superframes with CAP reduction */
+    EventQueue queue;
+    SimMedium medium(queue, 1);
+    SimPlatform node(0, queue, medium, 1);
+    NodeConfig config;
+    config.isPANCoordinator = true;
+    config.multiSuperframeOrder = 6;
+    node.initialize(config);
+
+    benchmarkACT<DSMEAllocationCounterTable>(bench, "ACT", node.getDSME());
+
+    bench.printReport(std::cout);
+    return 0;
+}
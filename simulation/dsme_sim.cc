@@ -0,0 +1,133 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/*
+ * Command line front end of the host-side simulation. Copy the headers from simulation/host
+ * next to the openDSME checkout and compile this file together with all openDSME sources.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "./Simulation.h"
+
+using namespace dsme::sim;
+
+static void printUsage(const char* name) {
+    std::cerr << "Usage: " << name << " [options]" << std::endl;
+    std::cerr << "  --nodes N       number of nodes including the PAN coordinator (default 8)" << std::endl;
+    std::cerr << "  --seed S        random seed (default 1)" << std::endl;
+    std::cerr << "  --warmup S      seconds without data traffic (default 60)" << std::endl;
+    std::cerr << "  --duration S    seconds with data traffic (default 120)" << std::endl;
+    std::cerr << "  --rate N        packets per minute and device (default 60)" << std::endl;
+    std::cerr << "  --payload N     payload length in bytes (default 20)" << std::endl;
+    std::cerr << "  --so N --mo N --bo N  superframe, multi-superframe and beacon order (default 3, 5, 6)" << std::endl;
+    std::cerr << "  --per N         packet error rate in per mille (default 0)" << std::endl;
+    std::cerr << "  --tickless N    1 to skip the slot events of idle slots (default 0)" << std::endl;
+    std::cerr << "  --late-every N --late-symbols M  fire every N-th timer interrupt M symbols late (default 0, 0)" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    SimulationConfig config;
+
+    for(int i = 1; i < argc; i++) {
+        if(i + 1 >= argc) {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        const char* option = argv[i];
+        unsigned long value = strtoul(argv[++i], nullptr, 0);
+
+        if(strcmp(option, "--nodes") == 0) {
+            config.numNodes = value;
+        } else if(strcmp(option, "--seed") == 0) {
+            config.seed = value;
+        } else if(strcmp(option, "--warmup") == 0) {
+            config.warmupSeconds = value;
+        } else if(strcmp(option, "--duration") == 0) {
+            config.durationSeconds = value;
+        } else if(strcmp(option, "--rate") == 0) {
+            config.packetsPerMinute = value;
+        } else if(strcmp(option, "--payload") == 0) {
+            config.payloadLength = value;
+        } else if(strcmp(option, "--so") == 0) {
+            config.node.superframeOrder = value;
+        } else if(strcmp(option, "--mo") == 0) {
+            config.node.multiSuperframeOrder = value;
+        } else if(strcmp(option, "--bo") == 0) {
+            config.node.beaconOrder = value;
+        } else if(strcmp(option, "--per") == 0) {
+            config.packetErrorRate = value;
+        } else if(strcmp(option, "--tickless") == 0) {
+            config.node.ticklessSlotTimer = (value != 0);
+        } else if(strcmp(option, "--late-every") == 0) {
+            config.node.lateEvery = value;
+        } else if(strcmp(option, "--late-symbols") == 0) {
+            config.node.lateSymbols = value;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if(config.numNodes < 1 || config.numNodes > MAX_NEIGHBORS) {
+        std::cerr << "The number of nodes has to be between 1 and " << MAX_NEIGHBORS << "." << std::endl;
+        return 1;
+    }
+
+    /* the superframes per beacon interval have to fit into the static tables of dsme_settings.h */
+    unsigned s = config.node.superframeOrder;
+    unsigned m = config.node.multiSuperframeOrder;
+    unsigned b = config.node.beaconOrder;
+    if(s > m || m > b || b > 14 || (1u << (b - s)) > MAX_TOTAL_SUPERFRAMES || (1u << (m - s)) > MAX_SUPERFRAMES_PER_MULTI_SUPERFRAME) {
+        std::cerr << "The orders have to satisfy so <= mo <= bo <= 14 with at most " << MAX_SUPERFRAMES_PER_MULTI_SUPERFRAME
+                  << " superframes per multi-superframe and " << MAX_TOTAL_SUPERFRAMES << " per beacon interval." << std::endl;
+        return 1;
+    }
+
+    Simulation simulation(config);
+    SimulationReport report = simulation.run();
+    report.print(std::cout);
+
+    return 0;
+}
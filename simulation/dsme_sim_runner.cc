@@ -0,0 +1,181 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/*
+ * Parameter sweep over independent PANs, executed on all cores. Every option except
+ * --threads accepts a comma separated list, the runner simulates the cross product.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "./SimulationRunner.h"
+
+using namespace dsme::sim;
+
+static void printUsage(const char* name) {
+    std::cerr << "Usage: " << name << " [options]" << std::endl;
+    std::cerr << "  --nodes N,...       number of nodes per PAN including the PAN coordinator (default 8)" << std::endl;
+    std::cerr << "  --so N,... --mo N,... --bo N,...  superframe, multi-superframe and beacon order (default 3, 5, 6)" << std::endl;
+    std::cerr << "  --scheduler S,...   tps or pid (default tps)" << std::endl;
+    std::cerr << "  --rate N,...        packets per minute and device (default 60)" << std::endl;
+    std::cerr << "  --seeds N           runs per configuration with the seeds 1 to N (default 1)" << std::endl;
+    std::cerr << "  --warmup S          seconds without data traffic (default 60)" << std::endl;
+    std::cerr << "  --duration S        seconds with data traffic (default 120)" << std::endl;
+    std::cerr << "  --threads N         worker threads, 0 for one per core (default 0)" << std::endl;
+}
+
+static std::vector<std::string> splitList(const char* list) {
+    std::vector<std::string> items;
+    std::string remaining(list);
+    size_t separator;
+    while((separator = remaining.find(',')) != std::string::npos) {
+        items.push_back(remaining.substr(0, separator));
+        remaining.erase(0, separator + 1);
+    }
+    items.push_back(remaining);
+    return items;
+}
+
+static std::vector<unsigned long> parseList(const char* list) {
+    std::vector<unsigned long> values;
+    for(const std::string& item : splitList(list)) {
+        values.push_back(strtoul(item.c_str(), nullptr, 0));
+    }
+    return values;
+}
+
+int main(int argc, char** argv) {
+    std::vector<unsigned long> nodes{8};
+    std::vector<unsigned long> so{3};
+    std::vector<unsigned long> mo{5};
+    std::vector<unsigned long> bo{6};
+    std::vector<unsigned long> rates{60};
+    std::vector<SchedulerType> schedulers{TPS_SCHEDULING};
+    unsigned long seeds = 1;
+    unsigned long threads = 0;
+    SimulationConfig base;
+
+    for(int i = 1; i < argc; i++) {
+        if(i + 1 >= argc) {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        const char* option = argv[i];
+        const char* value = argv[++i];
+
+        if(strcmp(option, "--nodes") == 0) {
+            nodes = parseList(value);
+        } else if(strcmp(option, "--so") == 0) {
+            so = parseList(value);
+        } else if(strcmp(option, "--mo") == 0) {
+            mo = parseList(value);
+        } else if(strcmp(option, "--bo") == 0) {
+            bo = parseList(value);
+        } else if(strcmp(option, "--rate") == 0) {
+            rates = parseList(value);
+        } else if(strcmp(option, "--scheduler") == 0) {
+            schedulers.clear();
+            for(const std::string& name : splitList(value)) {
+                if(name == "tps") {
+                    schedulers.push_back(TPS_SCHEDULING);
+                } else if(name == "pid") {
+                    schedulers.push_back(PID_SCHEDULING);
+                } else {
+                    printUsage(argv[0]);
+                    return 1;
+                }
+            }
+        } else if(strcmp(option, "--seeds") == 0) {
+            seeds = strtoul(value, nullptr, 0);
+        } else if(strcmp(option, "--warmup") == 0) {
+            base.warmupSeconds = strtoul(value, nullptr, 0);
+        } else if(strcmp(option, "--duration") == 0) {
+            base.durationSeconds = strtoul(value, nullptr, 0);
+        } else if(strcmp(option, "--threads") == 0) {
+            threads = strtoul(value, nullptr, 0);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    SimulationRunner runner;
+    for(unsigned long n : nodes) {
+        for(unsigned long s : so) {
+            for(unsigned long m : mo) {
+                for(unsigned long b : bo) {
+                    /* the superframes per beacon interval have to fit into the static tables of dsme_settings.h */
+                    if(n < 1 || n > MAX_NEIGHBORS || s > m || m > b || (1u << (b - s)) > MAX_TOTAL_SUPERFRAMES ||
+                       (1u << (m - s)) > MAX_SUPERFRAMES_PER_MULTI_SUPERFRAME) {
+                        std::cerr << "Skipping nodes=" << n << " so=" << s << " mo=" << m << " bo=" << b << ": not supported by dsme_settings.h"
+                                  << std::endl;
+                        continue;
+                    }
+                    for(SchedulerType scheduler : schedulers) {
+                        for(unsigned long rate : rates) {
+                            for(unsigned long seed = 1; seed <= seeds; seed++) {
+                                SimulationConfig config = base;
+                                config.numNodes = n;
+                                config.node.superframeOrder = s;
+                                config.node.multiSuperframeOrder = m;
+                                config.node.beaconOrder = b;
+                                config.node.scheduler = scheduler;
+                                config.packetsPerMinute = rate;
+                                config.seed = seed;
+                                runner.add(config);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    runner.run(threads);
+    runner.printReport(std::cout);
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef DSME_PLATFORM_H_
+#define DSME_PLATFORM_H_
+
+/*
+ * Platform header for the host-side simulation (see simulation/Simulation.h).
+ * Like every openDSME port, copy this file and its siblings from simulation/host/
+ * into the directory that contains the openDSME checkout.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include "./dsme_settings.h"
+
+/* 0: errors only, 1: additionally info, 2: additionally debug */
+#ifndef DSME_SIM_LOG_LEVEL
+#define DSME_SIM_LOG_LEVEL 0
+#endif
+
+namespace dsme {
+namespace sim {
+
+/* Implemented by the simulator, prints virtual time and node of the event currently executed */
+void printLogPrefix(std::ostream& stream);
+uint16_t currentNodeId();
+
+} /* namespace sim */
+} /* namespace dsme */
+
+#define DSME_SIM_LOG(level, x)                           \
+    do {                                                 \
+        if(DSME_SIM_LOG_LEVEL >= level) {                \
+            dsme::sim::printLogPrefix(std::cerr);        \
+            std::cerr << x << std::endl;                 \
+        }                                                \
+    } while(0)
+#define DSME_SIM_LOG_PREFIX(level)                       \
+    do {                                                 \
+        if(DSME_SIM_LOG_LEVEL >= level) {                \
+            dsme::sim::printLogPrefix(std::cerr);        \
+        }                                                \
+    } while(0)
+#define DSME_SIM_LOG_PURE(level, x)                      \
+    do {                                                 \
+        if(DSME_SIM_LOG_LEVEL >= level) {                \
+            std::cerr << x;                              \
+        }                                                \
+    } while(0)
+
+#define LOG_ERROR(x) DSME_SIM_LOG(0, x)
+#define LOG_INFO(x) DSME_SIM_LOG(1, x)
+#define LOG_DEBUG(x) DSME_SIM_LOG(2, x)
+#define LOG_ERROR_PREFIX DSME_SIM_LOG_PREFIX(0)
+#define LOG_INFO_PREFIX DSME_SIM_LOG_PREFIX(1)
+#define LOG_DEBUG_PREFIX DSME_SIM_LOG_PREFIX(2)
+#define LOG_ERROR_PURE(x) DSME_SIM_LOG_PURE(0, x)
+#define LOG_INFO_PURE(x) DSME_SIM_LOG_PURE(1, x)
+#define LOG_DEBUG_PURE(x) DSME_SIM_LOG_PURE(2, x)
+
+#define HEXOUT std::hex
+#define DECOUT std::dec
+#define LOG_ENDL std::endl
+#define FLOAT_OUTPUT(x) x
+
+#define palId_id() dsme::sim::currentNodeId()
+
+#define DSME_ASSERT(x)                                                                             \
+    do {                                                                                           \
+        if(!(x)) {                                                                                 \
+            dsme::sim::printLogPrefix(std::cerr);                                                  \
+            std::cerr << "Assertion '" #x "' failed at " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::abort();                                                                          \
+        }                                                                                          \
+    } while(0)
+#define DSME_SIM_ASSERT(x) DSME_ASSERT(x)
+#define ASSERT(x) DSME_ASSERT(x)
+
+#endif /* DSME_PLATFORM_H_ */
@@ -0,0 +1,82 @@
+/*
+ * openDSME
+ *
+ * Implementation of the Deterministic & Synchronous Multi-channel Extension (DSME)
+ * introduced in the IEEE 802.15.4e-2012 standard
+ *
+ * Authors: Florian Meier <florian.meier@tuhh.de>
+ *          Maximilian Koestler <maximilian.koestler@tuhh.de>
+ *          Sandrina Backhauss <sandrina.backhauss@tuhh.de>
+ *
+ * Based on
+ *          DSME Implementation for the INET Framework
+ *          Tobias Luebkert <tobias.luebkert@tuhh.de>
+ *
+ * Copyright (c) 2015, Institute of Telematics, Hamburg University of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef DSME_SETTINGS_H_
+#define DSME_SETTINGS_H_
+
+#include <cstdint>
+
+/*
+ * Settings for the host-side simulation, sized for MO - SO <= 3, 16 channels and
+ * PANs of a few dozen nodes.
+ */
+
+#define MAX_SUPERFRAMES_PER_MULTI_SUPERFRAME 8
+#define MAX_TOTAL_SUPERFRAMES 8
+#define MAX_GTSLOTS 15
+#define MAX_CHANNELS 16
+#define MAX_SAB_UNITS 1
+#define MAX_OCCUPIED_SLOTS (MAX_SUPERFRAMES_PER_MULTI_SUPERFRAME * MAX_GTSLOTS * MAX_CHANNELS)
+
+#define MAX_NEIGHBORS 32
+#define TOTAL_GTS_QUEUE_SIZE 64
+#define UPPER_LAYER_QUEUE_SIZE 32
+#define CAP_QUEUE_SIZE 16
+
+#define DSME_GTS_STATE_MULTIPLICITY 16
+
+#define DSME_GTS_QUEUE_PRIORITY_CLASSES 4
+
+#define PRE_EVENT_SHIFT 32
+#define ADDITIONAL_ACK_WAIT_DURATION 0
+
+namespace dsme {
+namespace const_redefines {
+
+/* IEEE 802.15.4-2015, 11.3, Table 11-1 */
+constexpr uint8_t macSIFSPeriod = 12;
+constexpr uint8_t macLIFSPeriod = 40;
+
+} /* namespace const_redefines */
+} /* namespace dsme */
+
+#endif /* DSME_SETTINGS_H_ */